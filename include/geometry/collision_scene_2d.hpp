@@ -0,0 +1,235 @@
+#pragma once
+
+#include "geometry/narrowphase_2d.hpp"
+#include "geometry/shapes_2d.hpp"
+#include "math/vector2.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace geometry {
+
+//Per-thread scratch for scene queries. An obstacle that spans several grid
+//cells is tested once per query: it is stamped with the query's epoch the
+//first time it is seen.
+struct CollisionWorkspace2d {
+    std::vector<uint32_t> stamp;
+    uint32_t epoch = 0;
+};
+
+//Static obstacle scene with a uniform-grid broadphase. Obstacles are added
+//first, then build() bins their bounding boxes into grid cells; a capsule
+//query only visits the cells under its own bounding box, so its cost depends
+//on the local obstacle density rather than the obstacle count.
+//Boxes and polygons are both stored as convex vertex loops.
+class CollisionScene2d {
+public:
+    size_t add(const Circle2d& c) {
+        circles_.push_back(c);
+        return push(Kind::Circle, circles_.size() - 1, c.aabb());
+    }
+
+    size_t add(const Capsule2d& c) {
+        capsules_.push_back(c);
+        return push(Kind::Capsule, capsules_.size() - 1, c.aabb());
+    }
+
+    size_t add(const Box2d& box) {
+        math::Vector2 v[4];
+        box.corners(v);
+        return add_convex(v, 4, box.aabb());
+    }
+
+    size_t add(const Polygon2d& poly) {
+        return add_convex(poly.vertices.data(), poly.vertices.size(), poly.aabb());
+    }
+
+    size_t size() const { return entries_.size(); }
+
+    bool built() const { return !cell_start_.empty(); }
+
+    //union of the obstacle bounding boxes
+    const AABB2d& bounds() const { return bounds_; }
+
+    //Bins the obstacles into square cells of side cell_size. With the default
+    //of 0 the side is the larger of the mean obstacle extent and the spacing
+    //that gives about one obstacle per cell.
+    void build(double cell_size = 0.0) {
+        if (entries_.empty()) {
+            cell_start_.assign(1, 0);
+            nx_ = ny_ = 0;
+            return;
+        }
+
+        const double w = bounds_.max.x - bounds_.min.x;
+        const double h = bounds_.max.y - bounds_.min.y;
+
+        if (cell_size <= 0.0) {
+            double extent = 0.0;
+            for (const Entry& e : entries_)
+                extent += std::max(e.box.max.x - e.box.min.x, e.box.max.y - e.box.min.y);
+            extent /= static_cast<double>(entries_.size());
+            cell_size = std::max(extent, std::sqrt(w * h / static_cast<double>(entries_.size())));
+            if (!(cell_size > 0.0))
+                cell_size = 1.0;
+        }
+
+        //clamped as doubles: a tiny cell_size would overflow int
+        inv_cell_ = 1.0 / cell_size;
+        nx_ = static_cast<int>(std::min<double>(kMaxCells - 1, w * inv_cell_)) + 1;
+        ny_ = static_cast<int>(std::min<double>(kMaxCells - 1, h * inv_cell_)) + 1;
+
+        //counting sort of (cell, obstacle) pairs into CSR arrays
+        cell_start_.assign(static_cast<size_t>(nx_) * ny_ + 1, 0);
+        for (const Entry& e : entries_)
+            for_cells(e.box, [&](size_t cell) { ++cell_start_[cell + 1]; });
+        for (size_t i = 1; i < cell_start_.size(); ++i)
+            cell_start_[i] += cell_start_[i - 1];
+
+        cell_items_.resize(cell_start_.back());
+        std::vector<uint32_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+        for (size_t k = 0; k < entries_.size(); ++k)
+            for_cells(entries_[k].box, [&](size_t cell) { cell_items_[fill[cell]++] = static_cast<uint32_t>(k); });
+    }
+
+    //true if the capsule touches any obstacle
+    bool intersects(const Capsule2d& cap, CollisionWorkspace2d& ws) const {
+        assert(built());
+
+        const AABB2d box = cap.aabb();
+        if (entries_.empty() || !box.overlaps(bounds_))
+            return false;
+
+        const uint32_t epoch = next_epoch(ws);
+
+        bool hit = false;
+        for_cells(box, [&](size_t cell) {
+            if (hit)
+                return;
+            for (uint32_t j = cell_start_[cell]; j < cell_start_[cell + 1]; ++j) {
+                const uint32_t k = cell_items_[j];
+                if (ws.stamp[k] == epoch)
+                    continue;
+                ws.stamp[k] = epoch;
+                if (entries_[k].box.overlaps(box) && test(entries_[k], cap)) {
+                    hit = true;
+                    return;
+                }
+            }
+        });
+        return hit;
+    }
+
+    //reference implementation without the broadphase
+    bool intersects_brute_force(const Capsule2d& cap) const {
+        for (const Entry& e : entries_)
+            if (test(e, cap))
+                return true;
+        return false;
+    }
+
+    //surface distance from the capsule to obstacle k, 0 on overlap
+    double distance(const Capsule2d& cap, size_t k) const {
+        const Entry& e = entries_[k];
+        switch (e.kind) {
+        case Kind::Circle:
+            return geometry::distance(cap, circles_[e.index]);
+        case Kind::Capsule:
+            return geometry::distance(cap, capsules_[e.index]);
+        default: {
+            const double d2 = segment_convex_distance2(cap.a, cap.b, convex_vertices(e.index), convex_size(e.index));
+            return std::max(0.0, std::sqrt(d2) - cap.radius);
+        }
+        }
+    }
+
+private:
+    enum class Kind : uint8_t { Circle, Capsule, Convex };
+
+    struct Entry {
+        Kind kind;
+        uint32_t index; //into the per-kind storage
+        AABB2d box;
+    };
+
+    static constexpr int kMaxCells = 1024; //per axis
+
+    size_t push(Kind kind, size_t index, const AABB2d& box) {
+        bounds_ = entries_.empty() ? box : bounds_.merged(box);
+        entries_.push_back(Entry{kind, static_cast<uint32_t>(index), box});
+        cell_start_.clear(); //needs a rebuild
+        return entries_.size() - 1;
+    }
+
+    size_t add_convex(const math::Vector2* v, size_t n, const AABB2d& box) {
+        if (convex_offsets_.empty())
+            convex_offsets_.push_back(0);
+        convex_vertices_.insert(convex_vertices_.end(), v, v + n);
+        convex_offsets_.push_back(static_cast<uint32_t>(convex_vertices_.size()));
+        return push(Kind::Convex, convex_offsets_.size() - 2, box);
+    }
+
+    const math::Vector2* convex_vertices(uint32_t i) const {
+        return convex_vertices_.data() + convex_offsets_[i];
+    }
+
+    size_t convex_size(uint32_t i) const {
+        return convex_offsets_[i + 1] - convex_offsets_[i];
+    }
+
+    bool test(const Entry& e, const Capsule2d& cap) const {
+        switch (e.kind) {
+        case Kind::Circle:
+            return geometry::intersects(cap, circles_[e.index]);
+        case Kind::Capsule:
+            return geometry::intersects(cap, capsules_[e.index]);
+        default:
+            return segment_convex_distance2(cap.a, cap.b, convex_vertices(e.index), convex_size(e.index))
+                <= cap.radius * cap.radius;
+        }
+    }
+
+    //calls fn(cell) for every grid cell under box, clamped to the grid
+    template <typename F>
+    void for_cells(const AABB2d& box, F&& fn) const {
+        const int x0 = clamp_cell((box.min.x - bounds_.min.x) * inv_cell_, nx_);
+        const int x1 = clamp_cell((box.max.x - bounds_.min.x) * inv_cell_, nx_);
+        const int y0 = clamp_cell((box.min.y - bounds_.min.y) * inv_cell_, ny_);
+        const int y1 = clamp_cell((box.max.y - bounds_.min.y) * inv_cell_, ny_);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                fn(static_cast<size_t>(y) * nx_ + x);
+    }
+
+    //clamped before the cast: boxes far outside bounds_ would overflow int
+    static int clamp_cell(double v, int n) {
+        return static_cast<int>(std::max(0.0, std::min(static_cast<double>(n - 1), std::floor(v))));
+    }
+
+    uint32_t next_epoch(CollisionWorkspace2d& ws) const {
+        if (ws.stamp.size() < entries_.size())
+            ws.stamp.resize(entries_.size(), 0);
+        if (++ws.epoch == 0) { //wrapped: old stamps could alias
+            std::fill(ws.stamp.begin(), ws.stamp.end(), 0);
+            ws.epoch = 1;
+        }
+        return ws.epoch;
+    }
+
+    std::vector<Entry> entries_;
+    std::vector<Circle2d> circles_;
+    std::vector<Capsule2d> capsules_;
+    std::vector<math::Vector2> convex_vertices_;
+    std::vector<uint32_t> convex_offsets_;
+
+    AABB2d bounds_;
+    double inv_cell_ = 1.0;
+    int nx_ = 0, ny_ = 0;
+    std::vector<uint32_t> cell_start_; //CSR offsets into cell_items_, nx * ny + 1
+    std::vector<uint32_t> cell_items_;
+};
+
+} // namespace geometry
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "geometry/shapes_2d.hpp"
+#include "math/vector2.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace geometry {
+
+//Exact pairwise tests between a capsule (an arm link) and the obstacle
+//primitives. Every test reduces to the distance from the capsule's core
+//segment to the other shape, compared against the summed radii; squared
+//distances are used until the final comparison.
+
+inline double point_segment_distance2(const math::Vector2& p,
+                                      const math::Vector2& a, const math::Vector2& b) {
+    const math::Vector2 ab = b - a;
+    const double len2 = ab.dot(ab);
+    double t = len2 > 0.0 ? (p - a).dot(ab) / len2 : 0.0;
+    t = std::max(0.0, std::min(1.0, t));
+    const math::Vector2 d = a + ab * t - p;
+    return d.dot(d);
+}
+
+//true if the closed segments a-b and c-d share a point
+inline bool segments_intersect(const math::Vector2& a, const math::Vector2& b,
+                               const math::Vector2& c, const math::Vector2& d) {
+    const double d1 = cross(b - a, c - a);
+    const double d2 = cross(b - a, d - a);
+    const double d3 = cross(d - c, a - c);
+    const double d4 = cross(d - c, b - c);
+
+    if (((d1 > 0.0 && d2 < 0.0) || (d1 < 0.0 && d2 > 0.0)) &&
+        ((d3 > 0.0 && d4 < 0.0) || (d3 < 0.0 && d4 > 0.0)))
+        return true;
+
+    //collinear or touching: fall back to the endpoint distances
+    return (d1 == 0.0 && point_segment_distance2(c, a, b) == 0.0) ||
+           (d2 == 0.0 && point_segment_distance2(d, a, b) == 0.0) ||
+           (d3 == 0.0 && point_segment_distance2(a, c, d) == 0.0) ||
+           (d4 == 0.0 && point_segment_distance2(b, c, d) == 0.0);
+}
+
+inline double segment_segment_distance2(const math::Vector2& a, const math::Vector2& b,
+                                        const math::Vector2& c, const math::Vector2& d) {
+    if (segments_intersect(a, b, c, d))
+        return 0.0;
+    //disjoint segments are closest at an endpoint of one of them
+    return std::min(std::min(point_segment_distance2(a, c, d), point_segment_distance2(b, c, d)),
+                    std::min(point_segment_distance2(c, a, b), point_segment_distance2(d, a, b)));
+}
+
+//p inside or on the boundary of the counter-clockwise convex polygon v[0..n)
+inline bool point_in_convex(const math::Vector2& p, const math::Vector2* v, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        const math::Vector2& a = v[i];
+        const math::Vector2& b = v[i + 1 == n ? 0 : i + 1];
+        if (cross(b - a, p - a) < 0.0)
+            return false;
+    }
+    return true;
+}
+
+//Squared distance from segment a-b to a counter-clockwise convex polygon,
+//zero if they overlap
+inline double segment_convex_distance2(const math::Vector2& a, const math::Vector2& b,
+                                       const math::Vector2* v, size_t n) {
+    if (point_in_convex(a, v, n))
+        return 0.0;
+
+    double best = INFINITY;
+    for (size_t i = 0; i < n; ++i) {
+        const double d = segment_segment_distance2(a, b, v[i], v[i + 1 == n ? 0 : i + 1]);
+        if (d == 0.0)
+            return 0.0;
+        best = std::min(best, d);
+    }
+    return best;
+}
+
+// ---- capsule vs primitive: distance between the surfaces, 0 on overlap ----
+
+inline double distance(const Capsule2d& cap, const Circle2d& circle) {
+    const double d = std::sqrt(point_segment_distance2(circle.center, cap.a, cap.b));
+    return std::max(0.0, d - cap.radius - circle.radius);
+}
+
+inline double distance(const Capsule2d& cap, const Capsule2d& other) {
+    const double d = std::sqrt(segment_segment_distance2(cap.a, cap.b, other.a, other.b));
+    return std::max(0.0, d - cap.radius - other.radius);
+}
+
+inline double distance(const Capsule2d& cap, const Box2d& box) {
+    math::Vector2 v[4];
+    box.corners(v);
+    return std::max(0.0, std::sqrt(segment_convex_distance2(cap.a, cap.b, v, 4)) - cap.radius);
+}
+
+inline double distance(const Capsule2d& cap, const Polygon2d& poly) {
+    const double d2 = segment_convex_distance2(cap.a, cap.b, poly.vertices.data(), poly.vertices.size());
+    return std::max(0.0, std::sqrt(d2) - cap.radius);
+}
+
+// ---- capsule vs primitive: overlap tests, no square roots ----
+
+inline bool intersects(const Capsule2d& cap, const Circle2d& circle) {
+    const double r = cap.radius + circle.radius;
+    return point_segment_distance2(circle.center, cap.a, cap.b) <= r * r;
+}
+
+inline bool intersects(const Capsule2d& cap, const Capsule2d& other) {
+    const double r = cap.radius + other.radius;
+    return segment_segment_distance2(cap.a, cap.b, other.a, other.b) <= r * r;
+}
+
+inline bool intersects(const Capsule2d& cap, const Box2d& box) {
+    math::Vector2 v[4];
+    box.corners(v);
+    return segment_convex_distance2(cap.a, cap.b, v, 4) <= cap.radius * cap.radius;
+}
+
+inline bool intersects(const Capsule2d& cap, const Polygon2d& poly) {
+    return segment_convex_distance2(cap.a, cap.b, poly.vertices.data(), poly.vertices.size())
+        <= cap.radius * cap.radius;
+}
+
+} // namespace geometry
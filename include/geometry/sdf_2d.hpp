@@ -0,0 +1,304 @@
+#pragma once
+
+#include "geometry/collision_scene_2d.hpp"
+#include "geometry/shapes_2d.hpp"
+#include "math/vector2.hpp"
+#include "util/thread_pool.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace geometry {
+
+//Signed distance field of a static scene sampled on a regular grid: positive
+//outside obstacles, negative inside. Values live at cell centres, cell (0, 0)
+//centred on origin(), stored row-major. Queries are O(1): bilinear
+//interpolation of the four surrounding samples. Points outside the grid are
+//clamped onto it, so the grid should enclose the workspace.
+//
+//Built by rasterising the scene's occupancy at the cell centres and running
+//the exact linear-time Euclidean distance transform of Felzenszwalb and
+//Huttenlocher (one 1D pass over columns, one over rows) twice: once to the
+//nearest occupied cell and once to the nearest free one. Both are shifted by
+//half a cell so the zero level falls between the two, which bounds the error
+//against the true distance by about one cell.
+class SignedDistanceField2d {
+public:
+    SignedDistanceField2d() = default;
+
+    //Grid covering region at the given cell size; every stage is split
+    //across the pool by row or column
+    static SignedDistanceField2d build(const CollisionScene2d& scene,
+                                       const AABB2d& region,
+                                       double resolution,
+                                       util::ThreadPool& pool)
+    {
+        assert(scene.built());
+        assert(resolution > 0.0);
+
+        SignedDistanceField2d sdf;
+        sdf.resolution_ = resolution;
+        sdf.origin_ = region.min;
+        sdf.nx_ = std::max<size_t>(2, static_cast<size_t>(std::ceil((region.max.x - region.min.x) / resolution)) + 1);
+        sdf.ny_ = std::max<size_t>(2, static_cast<size_t>(std::ceil((region.max.y - region.min.y) / resolution)) + 1);
+
+        const size_t nx = sdf.nx_, ny = sdf.ny_;
+
+        //occupancy at the cell centres: a point is a zero-radius capsule
+        std::vector<uint8_t> occupied(nx * ny);
+        std::vector<CollisionWorkspace2d> ws(pool.size());
+        pool.run(ny, [&](size_t y, size_t slot) {
+            for (size_t x = 0; x < nx; ++x) {
+                const math::Vector2 p = sdf.cell_center(x, y);
+                occupied[y * nx + x] = scene.intersects(Capsule2d{p, p, 0.0}, ws[slot]) ? 1 : 0;
+            }
+        });
+
+        std::vector<double> outside(nx * ny), inside(nx * ny);
+        distance_transform(occupied, 1, nx, ny, outside, pool);
+        distance_transform(occupied, 0, nx, ny, inside, pool);
+
+        sdf.data_.resize(nx * ny);
+        const double half = 0.5 * resolution;
+        for (size_t i = 0; i < nx * ny; ++i) {
+            sdf.data_[i] = occupied[i]
+                ? -(std::sqrt(inside[i]) * resolution - half)
+                : std::sqrt(outside[i]) * resolution - half;
+        }
+        return sdf;
+    }
+
+    //single-threaded build
+    static SignedDistanceField2d build(const CollisionScene2d& scene,
+                                       const AABB2d& region,
+                                       double resolution)
+    {
+        util::ThreadPool pool(1);
+        return build(scene, region, resolution, pool);
+    }
+
+    size_t width() const { return nx_; }
+    size_t height() const { return ny_; }
+    double resolution() const { return resolution_; }
+    const math::Vector2& origin() const { return origin_; }
+    bool empty() const { return data_.empty(); }
+
+    //raw sample at cell (x, y)
+    double at(size_t x, size_t y) const { return data_[y * nx_ + x]; }
+
+    math::Vector2 cell_center(size_t x, size_t y) const {
+        return math::Vector2{origin_.x + static_cast<double>(x) * resolution_,
+                             origin_.y + static_cast<double>(y) * resolution_};
+    }
+
+    //bilinearly interpolated signed distance at p
+    double distance(const math::Vector2& p) const {
+        Cell c = locate(p);
+        const double* r0 = data_.data() + c.y * nx_ + c.x;
+        const double* r1 = r0 + nx_;
+        const double a = r0[0] + c.fx * (r0[1] - r0[0]);
+        const double b = r1[0] + c.fx * (r1[1] - r1[0]);
+        return a + c.fy * (b - a);
+    }
+
+    //gradient of the bilinear interpolant at p; approximately the unit
+    //direction away from the nearest obstacle surface
+    math::Vector2 gradient(const math::Vector2& p) const {
+        Cell c = locate(p);
+        const double* r0 = data_.data() + c.y * nx_ + c.x;
+        const double* r1 = r0 + nx_;
+        const double inv = 1.0 / resolution_;
+        return math::Vector2{
+            ((1.0 - c.fy) * (r0[1] - r0[0]) + c.fy * (r1[1] - r1[0])) * inv,
+            ((1.0 - c.fx) * (r1[0] - r0[0]) + c.fx * (r1[1] - r0[1])) * inv
+        };
+    }
+
+    //Lower bound on the distance along the segment a-b. Samples at most one
+    //cell apart can only miss the minimum, never undershoot it: every point
+    //is within half a sample spacing h of a sample, so as the field is
+    //1-Lipschitz the true minimum is at least min(samples) - h / 2, which is
+    //what is returned.
+    double min_along(const math::Vector2& a, const math::Vector2& b) const {
+        const math::Vector2 ab = b - a;
+        const double length = ab.norm();
+        const size_t steps = std::max<size_t>(1, static_cast<size_t>(std::ceil(length / resolution_)));
+        const double inv = 1.0 / static_cast<double>(steps);
+
+        double best = distance(a);
+        for (size_t k = 1; k <= steps; ++k)
+            best = std::min(best, distance(a + ab * (static_cast<double>(k) * inv)));
+        return best - 0.5 * length * inv;
+    }
+
+    //Binary file: magic, version, grid size, origin, resolution, then the
+    //samples row-major in native byte order. Returns false on I/O failure.
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+            return false;
+
+        const uint64_t size[2] = {nx_, ny_};
+        const double geom[3] = {origin_.x, origin_.y, resolution_};
+        out.write(kMagic, sizeof(kMagic));
+        out.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+        out.write(reinterpret_cast<const char*>(size), sizeof(size));
+        out.write(reinterpret_cast<const char*>(geom), sizeof(geom));
+        out.write(reinterpret_cast<const char*>(data_.data()),
+                  static_cast<std::streamsize>(data_.size() * sizeof(double)));
+        return static_cast<bool>(out);
+    }
+
+    //Reads a file written by save(). Returns false, leaving sdf untouched, if
+    //the file is missing, truncated or of another format or version.
+    static bool load(const std::string& path, SignedDistanceField2d& sdf) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return false;
+
+        char magic[sizeof(kMagic)];
+        uint32_t version = 0;
+        uint64_t size[2];
+        double geom[3];
+        in.read(magic, sizeof(magic));
+        in.read(reinterpret_cast<char*>(&version), sizeof(version));
+        in.read(reinterpret_cast<char*>(size), sizeof(size));
+        in.read(reinterpret_cast<char*>(geom), sizeof(geom));
+        if (!in || !std::equal(magic, magic + sizeof(kMagic), kMagic) || version != kVersion)
+            return false;
+        if (size[0] < 2 || size[1] < 2 || size[0] > kMaxSide || size[1] > kMaxSide || !(geom[2] > 0.0))
+            return false;
+
+        //the header can claim up to 2^40 samples; check the file actually
+        //holds them before allocating
+        const std::streamoff at = in.tellg();
+        in.seekg(0, std::ios::end);
+        const std::streamoff end = in.tellg();
+        in.seekg(at);
+        if (!in || at < 0 || static_cast<uint64_t>(end - at) != size[0] * size[1] * sizeof(double))
+            return false;
+
+        std::vector<double> data(size[0] * size[1]);
+        in.read(reinterpret_cast<char*>(data.data()),
+                static_cast<std::streamsize>(data.size() * sizeof(double)));
+        if (!in)
+            return false;
+
+        sdf.nx_ = size[0];
+        sdf.ny_ = size[1];
+        sdf.origin_ = math::Vector2{geom[0], geom[1]};
+        sdf.resolution_ = geom[2];
+        sdf.data_ = std::move(data);
+        return true;
+    }
+
+private:
+    static constexpr char kMagic[4] = {'S', 'D', 'F', '2'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint64_t kMaxSide = uint64_t{1} << 20;
+
+    //stands in for infinity in the transform; keeps the parabola
+    //intersections finite
+    static constexpr double kFar = 1e20;
+
+    //lower-left sample of the interpolation cell and the fractions within it
+    struct Cell {
+        size_t x, y;
+        double fx, fy;
+    };
+
+    Cell locate(const math::Vector2& p) const {
+        assert(!empty());
+        const double u = std::max(0.0, std::min(static_cast<double>(nx_ - 1), (p.x - origin_.x) / resolution_));
+        const double v = std::max(0.0, std::min(static_cast<double>(ny_ - 1), (p.y - origin_.y) / resolution_));
+        const size_t x = std::min(static_cast<size_t>(u), nx_ - 2);
+        const size_t y = std::min(static_cast<size_t>(v), ny_ - 2);
+        return Cell{x, y, u - static_cast<double>(x), v - static_cast<double>(y)};
+    }
+
+    //Squared distance, in cells, from every cell to the nearest cell whose
+    //mask equals site
+    static void distance_transform(const std::vector<uint8_t>& mask, uint8_t site,
+                                   size_t nx, size_t ny, std::vector<double>& out,
+                                   util::ThreadPool& pool)
+    {
+        const size_t n = std::max(nx, ny);
+        std::vector<Scratch> scratch(pool.size(), Scratch(n));
+
+        //columns: distance along y to the nearest site
+        pool.run(nx, [&](size_t x, size_t slot) {
+            Scratch& s = scratch[slot];
+            for (size_t y = 0; y < ny; ++y)
+                s.f[y] = mask[y * nx + x] == site ? 0.0 : kFar;
+            transform_1d(s, ny);
+            for (size_t y = 0; y < ny; ++y)
+                out[y * nx + x] = s.d[y];
+        });
+
+        //rows: combine the column distances along x
+        pool.run(ny, [&](size_t y, size_t slot) {
+            Scratch& s = scratch[slot];
+            double* row = out.data() + y * nx;
+            std::copy(row, row + nx, s.f.begin());
+            transform_1d(s, nx);
+            std::copy(s.d.begin(), s.d.begin() + nx, row);
+        });
+    }
+
+    struct Scratch {
+        std::vector<double> f, d, z;
+        std::vector<size_t> v;
+
+        explicit Scratch(size_t n) : f(n), d(n), z(n + 1), v(n) {}
+    };
+
+    //1D squared distance transform of s.f[0..n) into s.d: the lower envelope
+    //of the parabolas (q - i)^2 + f[i]
+    static void transform_1d(Scratch& s, size_t n) {
+        const double* f = s.f.data();
+        size_t* v = s.v.data();
+        double* z = s.z.data();
+
+        auto intersect = [&](size_t q, size_t p) {
+            const double dq = static_cast<double>(q), dp = static_cast<double>(p);
+            return ((f[q] + dq * dq) - (f[p] + dp * dp)) / (2.0 * (dq - dp));
+        };
+
+        size_t k = 0;
+        v[0] = 0;
+        z[0] = -INFINITY;
+        z[1] = INFINITY;
+        for (size_t q = 1; q < n; ++q) {
+            double x = intersect(q, v[k]);
+            while (x <= z[k]) {
+                --k;
+                x = intersect(q, v[k]);
+            }
+            ++k;
+            v[k] = q;
+            z[k] = x;
+            z[k + 1] = INFINITY;
+        }
+
+        k = 0;
+        for (size_t q = 0; q < n; ++q) {
+            while (z[k + 1] < static_cast<double>(q))
+                ++k;
+            const double dq = static_cast<double>(q) - static_cast<double>(v[k]);
+            s.d[q] = dq * dq + f[v[k]];
+        }
+    }
+
+    math::Vector2 origin_;
+    double resolution_ = 0.0;
+    size_t nx_ = 0, ny_ = 0;
+    std::vector<double> data_;
+};
+
+} // namespace geometry
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "math/vector2.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace geometry {
+
+//z component of the 2D cross product
+inline double cross(const math::Vector2& a, const math::Vector2& b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+//Axis-aligned bounding box
+struct AABB2d {
+    math::Vector2 min, max;
+
+    bool overlaps(const AABB2d& other) const {
+        return min.x <= other.max.x && other.min.x <= max.x &&
+               min.y <= other.max.y && other.min.y <= max.y;
+    }
+
+    AABB2d inflated(double r) const {
+        return AABB2d{{min.x - r, min.y - r}, {max.x + r, max.y + r}};
+    }
+
+    AABB2d merged(const AABB2d& other) const {
+        return AABB2d{{std::min(min.x, other.min.x), std::min(min.y, other.min.y)},
+                      {std::max(max.x, other.max.x), std::max(max.y, other.max.y)}};
+    }
+};
+
+struct Circle2d {
+    math::Vector2 center;
+    double radius{0.0};
+
+    AABB2d aabb() const {
+        return AABB2d{center, center}.inflated(radius);
+    }
+};
+
+//Set of points within radius of the segment a-b. An arm link is a capsule
+//around the segment between two consecutive joint origins.
+struct Capsule2d {
+    math::Vector2 a, b;
+    double radius{0.0};
+
+    AABB2d aabb() const {
+        return AABB2d{{std::min(a.x, b.x), std::min(a.y, b.y)},
+                      {std::max(a.x, b.x), std::max(a.y, b.y)}}.inflated(radius);
+    }
+};
+
+//Oriented box: half extents along its own axes, rotated by angle about center
+struct Box2d {
+    math::Vector2 center;
+    math::Vector2 half;
+    double angle{0.0};
+
+    Box2d() = default;
+    Box2d(const math::Vector2& center_, const math::Vector2& half_, double angle_ = 0.0)
+        : center(center_), half(half_), angle(angle_) {}
+
+    //corners in counter-clockwise order
+    void corners(math::Vector2 out[4]) const {
+        const double c = std::cos(angle), s = std::sin(angle);
+        const math::Vector2 u{c * half.x, s * half.x};  //scaled local x axis
+        const math::Vector2 v{-s * half.y, c * half.y}; //scaled local y axis
+        out[0] = center - u - v;
+        out[1] = center + u - v;
+        out[2] = center + u + v;
+        out[3] = center - u + v;
+    }
+
+    AABB2d aabb() const {
+        const double c = std::abs(std::cos(angle)), s = std::abs(std::sin(angle));
+        const math::Vector2 e{c * half.x + s * half.y, s * half.x + c * half.y};
+        return AABB2d{center - e, center + e};
+    }
+};
+
+//Convex polygon. Vertices are stored counter-clockwise; a clockwise input is
+//reversed on construction.
+struct Polygon2d {
+    std::vector<math::Vector2> vertices;
+
+    Polygon2d() = default;
+
+    explicit Polygon2d(std::vector<math::Vector2> v)
+        : vertices(std::move(v)) {
+        assert(vertices.size() >= 3);
+        double area2 = 0.0;
+        for (size_t i = 0; i < vertices.size(); ++i)
+            area2 += cross(vertices[i], vertices[(i + 1) % vertices.size()]);
+        if (area2 < 0.0)
+            std::reverse(vertices.begin(), vertices.end());
+    }
+
+    AABB2d aabb() const {
+        AABB2d box{vertices[0], vertices[0]};
+        for (const auto& p : vertices)
+            box = box.merged(AABB2d{p, p});
+        return box;
+    }
+};
+
+} // namespace geometry
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include "vector3.hpp"
+#include "matrix3.hpp"
+
+namespace math {
+
+//Unit quaternion w + xi + yj + zk representing a 3D rotation. Composition is a
+//Hamilton product (16 mul) instead of a 3x3 matrix product (27 mul), and drift
+//off the unit sphere is repaired by renormalize().
+struct Quaternion {
+    double w{1.0};
+    double x{0.0};
+    double y{0.0};
+    double z{0.0};
+
+    Quaternion() = default;
+    Quaternion(double w_, double x_, double y_, double z_) : w(w_), x(x_), y(y_), z(z_) {}
+
+    static Quaternion identity() {
+        return Quaternion(1.0, 0.0, 0.0, 0.0);
+    }
+
+    //rotation by angle about a unit axis
+    static Quaternion from_axis_angle(const Vector3& axis, double angle) {
+        double h = 0.5 * angle;
+        double s = std::sin(h);
+        return Quaternion(std::cos(h), axis.x * s, axis.y * s, axis.z * s);
+    }
+
+    //from a rotation matrix; branches on the largest diagonal term so the
+    //square root never sees a small argument
+    static Quaternion from_matrix(const Matrix3& R) {
+        double tr = R.m00 + R.m11 + R.m22;
+        if (tr > 0.0) {
+            double s = 2.0 * std::sqrt(tr + 1.0);
+            return Quaternion(0.25 * s, (R.m21 - R.m12) / s, (R.m02 - R.m20) / s, (R.m10 - R.m01) / s);
+        }
+        if (R.m00 > R.m11 && R.m00 > R.m22) {
+            double s = 2.0 * std::sqrt(1.0 + R.m00 - R.m11 - R.m22);
+            return Quaternion((R.m21 - R.m12) / s, 0.25 * s, (R.m01 + R.m10) / s, (R.m02 + R.m20) / s);
+        }
+        if (R.m11 > R.m22) {
+            double s = 2.0 * std::sqrt(1.0 + R.m11 - R.m00 - R.m22);
+            return Quaternion((R.m02 - R.m20) / s, (R.m01 + R.m10) / s, 0.25 * s, (R.m12 + R.m21) / s);
+        }
+        double s = 2.0 * std::sqrt(1.0 + R.m22 - R.m00 - R.m11);
+        return Quaternion((R.m10 - R.m01) / s, (R.m02 + R.m20) / s, (R.m12 + R.m21) / s, 0.25 * s);
+    }
+
+    Matrix3 to_matrix() const {
+        double xx = x * x, yy = y * y, zz = z * z;
+        double xy = x * y, xz = x * z, yz = y * z;
+        double wx = w * x, wy = w * y, wz = w * z;
+        return {
+            1.0 - 2.0 * (yy + zz), 2.0 * (xy - wz),       2.0 * (xz + wy),
+            2.0 * (xy + wz),       1.0 - 2.0 * (xx + zz), 2.0 * (yz - wx),
+            2.0 * (xz - wy),       2.0 * (yz + wx),       1.0 - 2.0 * (xx + yy)
+        };
+    }
+
+    //composition (Hamilton product)
+    Quaternion operator*(const Quaternion& o) const {
+        return {
+            w * o.w - x * o.x - y * o.y - z * o.z,
+            w * o.x + x * o.w + y * o.z - z * o.y,
+            w * o.y - x * o.z + y * o.w + z * o.x,
+            w * o.z + x * o.y - y * o.x + z * o.w
+        };
+    }
+
+    //rotate a vector: v + 2w (u x v) + 2 u x (u x v), u = (x, y, z)
+    Vector3 operator*(const Vector3& v) const {
+        Vector3 u{x, y, z};
+        Vector3 c = u.cross(v) * 2.0;
+        return v + c * w + u.cross(c);
+    }
+
+    //inverse of a unit quaternion (conjugate)
+    Quaternion inverse() const {
+        return Quaternion(w, -x, -y, -z);
+    }
+
+    double norm() const {
+        return std::sqrt(w * w + x * x + y * y + z * z);
+    }
+
+    //Pulls the quaternion back onto the unit sphere. One Newton step for
+    //1/sqrt(n), no sqrt or division; exact to rounding while |n - 1| is small,
+    //which holds when called every few dozen compositions.
+    void renormalize() {
+        double k = 0.5 * (3.0 - (w * w + x * x + y * y + z * z));
+        w *= k;
+        x *= k;
+        y *= k;
+        z *= k;
+    }
+};
+
+//Batched conversions, e.g. for pose caches and trajectory buffers
+inline void to_matrices(const Quaternion* q, Matrix3* R, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        R[i] = q[i].to_matrix();
+}
+
+inline void from_matrices(const Matrix3* R, Quaternion* q, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        q[i] = Quaternion::from_matrix(R[i]);
+}
+
+//Pretty printing
+inline std::ostream& operator<<(std::ostream& os, const Quaternion& q) {
+    return os << "Quaternion(" << q.w << ", " << q.x << ", " << q.y << ", " << q.z << ")";
+}
+
+} //namespace math
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "vector2.hpp"
+#include "so2.hpp"
+#include "se2.hpp"
+#include <ostream>
+
+namespace math {
+
+//SE2 with the rotation stored as SO2: 4 doubles instead of 6, and composition
+//costs 8 mul instead of 12. Converts to and from the Matrix2-based SE2.
+struct SE2Compact {
+    SO2 R;     //rotation
+    Vector2 t; //translation
+
+    SE2Compact() = default;
+
+    SE2Compact(const SO2& R_in, const Vector2& t_in)
+        : R(R_in), t(t_in) {}
+
+    explicit SE2Compact(const SE2& T)
+        : R(SO2::from_matrix(T.R)), t(T.t) {}
+
+    static SE2Compact from_angle_translation(double theta, const Vector2& t_in) {
+        return SE2Compact(SO2::from_angle(theta), t_in);
+    }
+
+    SE2 to_se2() const {
+        return SE2(R.to_matrix(), t);
+    }
+
+    //composition
+    SE2Compact operator*(const SE2Compact& other) const {
+        return SE2Compact(R * other.R, R * other.t + t);
+    }
+
+    //inverse
+    SE2Compact inverse() const {
+        SO2 Rt = R.inverse();
+        return SE2Compact(Rt, Rt * (t * -1.0));
+    }
+
+    //transform point
+    Vector2 operator*(const Vector2& p) const {
+        return R * p + t;
+    }
+
+    void renormalize() {
+        R.renormalize();
+    }
+};
+
+//Pretty printing
+inline std::ostream& operator<<(std::ostream& os, const SE2Compact& T) {
+    return os << "SE2Compact(R=" << T.R << ", t=" << T.t << ")";
+}
+
+} //namespace math
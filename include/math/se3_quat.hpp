@@ -0,0 +1,66 @@
+#pragma once
+
+#include "vector3.hpp"
+#include "quaternion.hpp"
+#include "se3.hpp"
+#include <cstddef>
+#include <ostream>
+
+namespace math {
+
+//SE3 with the rotation stored as a unit quaternion: 7 doubles instead of 12.
+//Converts to and from the Matrix3-based SE3.
+struct SE3Quat {
+    Quaternion q; //rotation
+    Vector3 t;    //translation
+
+    SE3Quat() = default;
+
+    SE3Quat(const Quaternion& q_in, const Vector3& t_in)
+        : q(q_in), t(t_in) {}
+
+    explicit SE3Quat(const SE3& T)
+        : q(Quaternion::from_matrix(T.R)), t(T.t) {}
+
+    SE3 to_se3() const {
+        return SE3(q.to_matrix(), t);
+    }
+
+    //composition
+    SE3Quat operator*(const SE3Quat& other) const {
+        return SE3Quat(q * other.q, q * other.t + t);
+    }
+
+    //inverse
+    SE3Quat inverse() const {
+        Quaternion qi = q.inverse();
+        return SE3Quat(qi, qi * (t * -1.0));
+    }
+
+    //transform a point
+    Vector3 operator*(const Vector3& p) const {
+        return q * p + t;
+    }
+
+    void renormalize() {
+        q.renormalize();
+    }
+};
+
+//Batched conversions
+inline void to_se3(const SE3Quat* in, SE3* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = in[i].to_se3();
+}
+
+inline void from_se3(const SE3* in, SE3Quat* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = SE3Quat(in[i]);
+}
+
+//Pretty printing
+inline std::ostream& operator<<(std::ostream& os, const SE3Quat& T) {
+    return os << "SE3Quat(q=" << T.q << ", t=" << T.t << ")";
+}
+
+} //namespace math
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cmath>
+#include <ostream>
+#include "vector2.hpp"
+#include "matrix2.hpp"
+
+namespace math {
+
+//Planar rotation stored as the unit complex number (cos, sin). Composition is a
+//complex multiply (4 mul) instead of a 2x2 matrix product (8 mul); long chains
+//of compositions drift off the unit circle and should call renormalize()
+//every few dozen steps.
+struct SO2 {
+    double c{1.0}; //cos(angle)
+    double s{0.0}; //sin(angle)
+
+    SO2() = default;
+    SO2(double c_, double s_) : c(c_), s(s_) {}
+
+    static SO2 from_angle(double theta) {
+        return SO2(std::cos(theta), std::sin(theta));
+    }
+
+    //from a rotation matrix (first column)
+    static SO2 from_matrix(const Matrix2& R) {
+        return SO2(R.m00, R.m10);
+    }
+
+    Matrix2 to_matrix() const {
+        return Matrix2(c, -s,
+                       s, c);
+    }
+
+    double angle() const {
+        return std::atan2(s, c);
+    }
+
+    //composition
+    SO2 operator*(const SO2& other) const {
+        return SO2(c * other.c - s * other.s,
+                   s * other.c + c * other.s);
+    }
+
+    //rotate a vector
+    Vector2 operator*(const Vector2& v) const {
+        return {c * v.x - s * v.y,
+                s * v.x + c * v.y};
+    }
+
+    //inverse (complex conjugate)
+    SO2 inverse() const {
+        return SO2(c, -s);
+    }
+
+    //Pulls (c, s) back onto the unit circle. One Newton step for 1/sqrt(n),
+    //no sqrt or division; exact to rounding while |n - 1| stays small.
+    void renormalize() {
+        double k = 0.5 * (3.0 - (c * c + s * s));
+        c *= k;
+        s *= k;
+    }
+};
+
+//Pretty printing
+inline std::ostream& operator<<(std::ostream& os, const SO2& R) {
+    return os << "SO2(c=" << R.c << ", s=" << R.s << ")";
+}
+
+} //namespace math
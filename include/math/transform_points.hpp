@@ -0,0 +1,243 @@
+#pragma once
+
+#include "vector2.hpp"
+#include "vector3.hpp"
+#include "se2.hpp"
+#include "se3.hpp"
+#include <cstddef>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//Bulk rigid transforms of point sets, p' = R * p + t for every point.
+//Array-of-structs (Vector2[] / Vector3[]) and structure-of-arrays (separate
+//x/y/z arrays) layouts are supported, each out-of-place and in-place. Output
+//arrays may be the input arrays themselves but must not partially overlap them.
+//AVX kernels are used when compiled with -mavx (see ROBOT_ENABLE_AVX), SSE2
+//otherwise on x86-64, and a scalar loop elsewhere and for the remainder.
+
+namespace math {
+
+static_assert(sizeof(Vector2) == 2 * sizeof(double), "Vector2 must be two packed doubles");
+static_assert(sizeof(Vector3) == 3 * sizeof(double), "Vector3 must be three packed doubles");
+
+// --------------------------------
+// SE2
+// --------------------------------
+
+//AoS, out-of-place (out may equal in)
+inline void transform_points(const SE2& T, const Vector2* in, Vector2* out, std::size_t n) {
+    const Matrix2& R = T.R;
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    //two points per register: (x0, y0, x1, y1)
+    const __m256d c0 = _mm256_setr_pd(R.m00, R.m10, R.m00, R.m10);
+    const __m256d c1 = _mm256_setr_pd(R.m01, R.m11, R.m01, R.m11);
+    const __m256d t = _mm256_setr_pd(T.t.x, T.t.y, T.t.x, T.t.y);
+    for (; i + 2 <= n; i += 2) {
+        __m256d p = _mm256_loadu_pd(&in[i].x);
+        __m256d x = _mm256_permute_pd(p, 0x0); //(x0, x0, x1, x1)
+        __m256d y = _mm256_permute_pd(p, 0xF); //(y0, y0, y1, y1)
+        __m256d r = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(c0, x), _mm256_mul_pd(c1, y)), t);
+        _mm256_storeu_pd(&out[i].x, r);
+    }
+#elif defined(__SSE2__)
+    const __m128d c0 = _mm_setr_pd(R.m00, R.m10);
+    const __m128d c1 = _mm_setr_pd(R.m01, R.m11);
+    const __m128d t = _mm_setr_pd(T.t.x, T.t.y);
+    for (; i < n; ++i) {
+        __m128d p = _mm_loadu_pd(&in[i].x);
+        __m128d x = _mm_unpacklo_pd(p, p);
+        __m128d y = _mm_unpackhi_pd(p, p);
+        _mm_storeu_pd(&out[i].x, _mm_add_pd(_mm_add_pd(_mm_mul_pd(c0, x), _mm_mul_pd(c1, y)), t));
+    }
+#endif
+
+    for (; i < n; ++i)
+        out[i] = T * in[i];
+}
+
+//AoS, in-place
+inline void transform_points(const SE2& T, Vector2* points, std::size_t n) {
+    transform_points(T, points, points, n);
+}
+
+//SoA, out-of-place (outputs may equal inputs)
+inline void transform_points(const SE2& T,
+                             const double* x, const double* y,
+                             double* out_x, double* out_y, std::size_t n) {
+    const Matrix2& R = T.R;
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256d m00 = _mm256_set1_pd(R.m00), m01 = _mm256_set1_pd(R.m01);
+    const __m256d m10 = _mm256_set1_pd(R.m10), m11 = _mm256_set1_pd(R.m11);
+    const __m256d tx = _mm256_set1_pd(T.t.x), ty = _mm256_set1_pd(T.t.y);
+    for (; i + 4 <= n; i += 4) {
+        __m256d px = _mm256_loadu_pd(x + i);
+        __m256d py = _mm256_loadu_pd(y + i);
+        __m256d rx = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m00, px), _mm256_mul_pd(m01, py)), tx);
+        __m256d ry = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m10, px), _mm256_mul_pd(m11, py)), ty);
+        _mm256_storeu_pd(out_x + i, rx);
+        _mm256_storeu_pd(out_y + i, ry);
+    }
+#elif defined(__SSE2__)
+    const __m128d m00 = _mm_set1_pd(R.m00), m01 = _mm_set1_pd(R.m01);
+    const __m128d m10 = _mm_set1_pd(R.m10), m11 = _mm_set1_pd(R.m11);
+    const __m128d tx = _mm_set1_pd(T.t.x), ty = _mm_set1_pd(T.t.y);
+    for (; i + 2 <= n; i += 2) {
+        __m128d px = _mm_loadu_pd(x + i);
+        __m128d py = _mm_loadu_pd(y + i);
+        __m128d rx = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m00, px), _mm_mul_pd(m01, py)), tx);
+        __m128d ry = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m10, px), _mm_mul_pd(m11, py)), ty);
+        _mm_storeu_pd(out_x + i, rx);
+        _mm_storeu_pd(out_y + i, ry);
+    }
+#endif
+
+    for (; i < n; ++i) {
+        double px = x[i], py = y[i];
+        out_x[i] = R.m00 * px + R.m01 * py + T.t.x;
+        out_y[i] = R.m10 * px + R.m11 * py + T.t.y;
+    }
+}
+
+//SoA, in-place
+inline void transform_points(const SE2& T, double* x, double* y, std::size_t n) {
+    transform_points(T, x, y, x, y, n);
+}
+
+// --------------------------------
+// SE3
+// --------------------------------
+
+//AoS, out-of-place (out may equal in)
+inline void transform_points(const SE3& T, const Vector3* in, Vector3* out, std::size_t n) {
+    const Matrix3& R = T.R;
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    //four points are three registers; transpose them to x/y/z lanes and back
+    const __m256d m00 = _mm256_set1_pd(R.m00), m01 = _mm256_set1_pd(R.m01), m02 = _mm256_set1_pd(R.m02);
+    const __m256d m10 = _mm256_set1_pd(R.m10), m11 = _mm256_set1_pd(R.m11), m12 = _mm256_set1_pd(R.m12);
+    const __m256d m20 = _mm256_set1_pd(R.m20), m21 = _mm256_set1_pd(R.m21), m22 = _mm256_set1_pd(R.m22);
+    const __m256d tx = _mm256_set1_pd(T.t.x), ty = _mm256_set1_pd(T.t.y), tz = _mm256_set1_pd(T.t.z);
+    for (; i + 4 <= n; i += 4) {
+        const double* src = &in[i].x;
+        __m256d a = _mm256_loadu_pd(src);     //x0 y0 z0 x1
+        __m256d b = _mm256_loadu_pd(src + 4); //y1 z1 x2 y2
+        __m256d c = _mm256_loadu_pd(src + 8); //z2 x3 y3 z3
+
+        __m256d r0 = _mm256_permute2f128_pd(a, b, 0x30); //x0 y0 x2 y2
+        __m256d r1 = _mm256_permute2f128_pd(a, c, 0x21); //z0 x1 z2 x3
+        __m256d r2 = _mm256_permute2f128_pd(b, c, 0x30); //y1 z1 y3 z3
+
+        __m256d px = _mm256_shuffle_pd(r0, r1, 0xA);
+        __m256d py = _mm256_shuffle_pd(r0, r2, 0x5);
+        __m256d pz = _mm256_shuffle_pd(r1, r2, 0xA);
+
+        __m256d qx = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(m00, px), _mm256_mul_pd(m01, py)), _mm256_mul_pd(m02, pz)), tx);
+        __m256d qy = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(m10, px), _mm256_mul_pd(m11, py)), _mm256_mul_pd(m12, pz)), ty);
+        __m256d qz = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(m20, px), _mm256_mul_pd(m21, py)), _mm256_mul_pd(m22, pz)), tz);
+
+        r0 = _mm256_shuffle_pd(qx, qy, 0x0); //x0 y0 x2 y2
+        r1 = _mm256_shuffle_pd(qz, qx, 0xA); //z0 x1 z2 x3
+        r2 = _mm256_shuffle_pd(qy, qz, 0xF); //y1 z1 y3 z3
+
+        double* dst = &out[i].x;
+        _mm256_storeu_pd(dst,     _mm256_permute2f128_pd(r0, r1, 0x20));
+        _mm256_storeu_pd(dst + 4, _mm256_permute2f128_pd(r2, r0, 0x30));
+        _mm256_storeu_pd(dst + 8, _mm256_permute2f128_pd(r1, r2, 0x31));
+    }
+#elif defined(__SSE2__)
+    //x/y of one point in a register, z on the scalar side
+    const __m128d c0 = _mm_setr_pd(R.m00, R.m10);
+    const __m128d c1 = _mm_setr_pd(R.m01, R.m11);
+    const __m128d c2 = _mm_setr_pd(R.m02, R.m12);
+    const __m128d t = _mm_setr_pd(T.t.x, T.t.y);
+    for (; i < n; ++i) {
+        const double x = in[i].x, y = in[i].y, z = in[i].z;
+        __m128d xy = _mm_add_pd(_mm_add_pd(_mm_add_pd(
+            _mm_mul_pd(c0, _mm_set1_pd(x)), _mm_mul_pd(c1, _mm_set1_pd(y))), _mm_mul_pd(c2, _mm_set1_pd(z))), t);
+        _mm_storeu_pd(&out[i].x, xy);
+        out[i].z = R.m20 * x + R.m21 * y + R.m22 * z + T.t.z;
+    }
+#endif
+
+    for (; i < n; ++i)
+        out[i] = T * in[i];
+}
+
+//AoS, in-place
+inline void transform_points(const SE3& T, Vector3* points, std::size_t n) {
+    transform_points(T, points, points, n);
+}
+
+//SoA, out-of-place (outputs may equal inputs)
+inline void transform_points(const SE3& T,
+                             const double* x, const double* y, const double* z,
+                             double* out_x, double* out_y, double* out_z, std::size_t n) {
+    const Matrix3& R = T.R;
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256d m00 = _mm256_set1_pd(R.m00), m01 = _mm256_set1_pd(R.m01), m02 = _mm256_set1_pd(R.m02);
+    const __m256d m10 = _mm256_set1_pd(R.m10), m11 = _mm256_set1_pd(R.m11), m12 = _mm256_set1_pd(R.m12);
+    const __m256d m20 = _mm256_set1_pd(R.m20), m21 = _mm256_set1_pd(R.m21), m22 = _mm256_set1_pd(R.m22);
+    const __m256d tx = _mm256_set1_pd(T.t.x), ty = _mm256_set1_pd(T.t.y), tz = _mm256_set1_pd(T.t.z);
+    for (; i + 4 <= n; i += 4) {
+        __m256d px = _mm256_loadu_pd(x + i);
+        __m256d py = _mm256_loadu_pd(y + i);
+        __m256d pz = _mm256_loadu_pd(z + i);
+        __m256d qx = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(m00, px), _mm256_mul_pd(m01, py)), _mm256_mul_pd(m02, pz)), tx);
+        __m256d qy = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(m10, px), _mm256_mul_pd(m11, py)), _mm256_mul_pd(m12, pz)), ty);
+        __m256d qz = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(m20, px), _mm256_mul_pd(m21, py)), _mm256_mul_pd(m22, pz)), tz);
+        _mm256_storeu_pd(out_x + i, qx);
+        _mm256_storeu_pd(out_y + i, qy);
+        _mm256_storeu_pd(out_z + i, qz);
+    }
+#elif defined(__SSE2__)
+    const __m128d m00 = _mm_set1_pd(R.m00), m01 = _mm_set1_pd(R.m01), m02 = _mm_set1_pd(R.m02);
+    const __m128d m10 = _mm_set1_pd(R.m10), m11 = _mm_set1_pd(R.m11), m12 = _mm_set1_pd(R.m12);
+    const __m128d m20 = _mm_set1_pd(R.m20), m21 = _mm_set1_pd(R.m21), m22 = _mm_set1_pd(R.m22);
+    const __m128d tx = _mm_set1_pd(T.t.x), ty = _mm_set1_pd(T.t.y), tz = _mm_set1_pd(T.t.z);
+    for (; i + 2 <= n; i += 2) {
+        __m128d px = _mm_loadu_pd(x + i);
+        __m128d py = _mm_loadu_pd(y + i);
+        __m128d pz = _mm_loadu_pd(z + i);
+        __m128d qx = _mm_add_pd(_mm_add_pd(_mm_add_pd(
+            _mm_mul_pd(m00, px), _mm_mul_pd(m01, py)), _mm_mul_pd(m02, pz)), tx);
+        __m128d qy = _mm_add_pd(_mm_add_pd(_mm_add_pd(
+            _mm_mul_pd(m10, px), _mm_mul_pd(m11, py)), _mm_mul_pd(m12, pz)), ty);
+        __m128d qz = _mm_add_pd(_mm_add_pd(_mm_add_pd(
+            _mm_mul_pd(m20, px), _mm_mul_pd(m21, py)), _mm_mul_pd(m22, pz)), tz);
+        _mm_storeu_pd(out_x + i, qx);
+        _mm_storeu_pd(out_y + i, qy);
+        _mm_storeu_pd(out_z + i, qz);
+    }
+#endif
+
+    for (; i < n; ++i) {
+        double px = x[i], py = y[i], pz = z[i];
+        out_x[i] = R.m00 * px + R.m01 * py + R.m02 * pz + T.t.x;
+        out_y[i] = R.m10 * px + R.m11 * py + R.m12 * pz + T.t.y;
+        out_z[i] = R.m20 * px + R.m21 * py + R.m22 * pz + T.t.z;
+    }
+}
+
+//SoA, in-place
+inline void transform_points(const SE3& T, double* x, double* y, double* z, std::size_t n) {
+    transform_points(T, x, y, z, x, y, z, n);
+}
+
+} //namespace math
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "geometry/sdf_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+
+namespace robot {
+
+//Clearance of a RobotArm2d's links from a precomputed signed distance field.
+//Each link is a capsule of link_radius around the segment between
+//consecutive joint origins, like in ArmCollision2d; its clearance is the
+//smallest field value along the segment minus the radius, negative when the
+//link penetrates an obstacle. The field must outlive this object.
+struct ArmClearance2d {
+    const RobotArm2d& arm;
+    const geometry::SignedDistanceField2d& sdf;
+    double link_radius = 0.0;
+
+    ArmClearance2d(const RobotArm2d& arm_, const geometry::SignedDistanceField2d& sdf_, double link_radius_)
+        : arm(arm_), sdf(sdf_), link_radius(link_radius_) {}
+
+    //clearance[i] receives the clearance of link i; returns the smallest.
+    //points is scratch for the link end points.
+    double link_clearance(const std::vector<double>& q,
+                          std::vector<double>& clearance,
+                          std::vector<math::Vector2>& points) const {
+        arm.link_points(q, points);
+
+        const size_t N = arm.link_lengths.size();
+        clearance.resize(N);
+
+        double best = INFINITY;
+        for (size_t i = 0; i < N; ++i) {
+            clearance[i] = sdf.min_along(points[i], points[i + 1]) - link_radius;
+            best = std::min(best, clearance[i]);
+        }
+        return best;
+    }
+
+    //smallest link clearance only
+    double min_clearance(const std::vector<double>& q,
+                         std::vector<math::Vector2>& points) const {
+        arm.link_points(q, points);
+
+        double best = INFINITY;
+        for (size_t i = 0; i + 1 < points.size(); ++i)
+            best = std::min(best, sdf.min_along(points[i], points[i + 1]));
+        return best - link_radius;
+    }
+};
+
+} // namespace robot
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "geometry/collision_scene_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+
+namespace robot {
+
+//Scratch for ArmCollision2d: the link end points and the scene query stamps
+struct ArmCollisionWorkspace2d {
+    std::vector<double> q;
+    std::vector<math::Vector2> points;
+    geometry::CollisionWorkspace2d scene;
+};
+
+//Link-vs-environment collision checks for a RobotArm2d. Every link is a
+//capsule of link_radius around the segment between consecutive joint
+//origins (the last one ends at the end effector). The scene must be built
+//and must outlive the checker.
+struct ArmCollision2d {
+    const RobotArm2d& arm;
+    const geometry::CollisionScene2d& scene;
+    double link_radius = 0.0;
+
+    ArmCollision2d(const RobotArm2d& arm_, const geometry::CollisionScene2d& scene_, double link_radius_)
+        : arm(arm_), scene(scene_), link_radius(link_radius_) {
+        assert(scene.built());
+    }
+
+    //true if any link touches an obstacle
+    bool in_collision(const std::vector<double>& q, ArmCollisionWorkspace2d& ws) const {
+        arm.link_points(q, ws.points);
+        for (size_t i = 0; i + 1 < ws.points.size(); ++i) {
+            const geometry::Capsule2d link{ws.points[i], ws.points[i + 1], link_radius};
+            if (scene.intersects(link, ws.scene))
+                return true;
+        }
+        return false;
+    }
+
+    //Validity callback for planners such as RRTConnect2d: true if the
+    //configuration q[0..dof) is collision free. Uses per-thread scratch.
+    bool operator()(const double* q) const {
+        thread_local ArmCollisionWorkspace2d ws;
+        ws.q.assign(q, q + arm.link_lengths.size());
+        return !in_collision(ws.q, ws);
+    }
+
+    //Checks `count` configurations stored back to back (q[b * dof + i] is
+    //joint i of configuration b) and writes free[b] = 1 if configuration b
+    //is collision free, 0 otherwise. Work is split into chunks of kBatchChunk
+    //configurations across the pool, each slot with its own workspace.
+    void check_batch(const double* q, size_t count, uint8_t* free,
+                     util::ThreadPool& pool) const {
+        const size_t N = arm.link_lengths.size();
+        const size_t chunks = (count + kBatchChunk - 1) / kBatchChunk;
+
+        std::vector<ArmCollisionWorkspace2d> ws(pool.size());
+        pool.run(chunks, [&](size_t chunk, size_t slot) {
+            ArmCollisionWorkspace2d& w = ws[slot];
+            const size_t end = std::min(count, (chunk + 1) * kBatchChunk);
+            for (size_t b = chunk * kBatchChunk; b < end; ++b) {
+                w.q.assign(q + b * N, q + (b + 1) * N);
+                free[b] = in_collision(w.q, w) ? 0 : 1;
+            }
+        });
+    }
+
+    static constexpr size_t kBatchChunk = 64;
+};
+
+} // namespace robot
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "robot/ik_2d.hpp"
+#include "robot/ik_2d_path.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "math/vector2.hpp"
+
+namespace robot {
+
+//One piece of an end-effector path: a straight line or a circular arc,
+//parameterised by s in [0, 1]
+struct CartesianSegment2d {
+    enum class Kind { Line, Arc };
+
+    Kind kind = Kind::Line;
+    math::Vector2 start, end; //line end points
+    math::Vector2 center;     //arc centre
+    double radius = 0.0;
+    double angle0 = 0.0;      //arc start angle
+    double sweep = 0.0;       //signed arc angle, positive is counter-clockwise
+
+    static CartesianSegment2d line(const math::Vector2& a, const math::Vector2& b) {
+        CartesianSegment2d seg;
+        seg.kind = Kind::Line;
+        seg.start = a;
+        seg.end = b;
+        return seg;
+    }
+
+    static CartesianSegment2d arc(const math::Vector2& center, double radius,
+                                  double angle0, double sweep) {
+        CartesianSegment2d seg;
+        seg.kind = Kind::Arc;
+        seg.center = center;
+        seg.radius = radius;
+        seg.angle0 = angle0;
+        seg.sweep = sweep;
+        seg.start = seg.point(0.0);
+        seg.end = seg.point(1.0);
+        return seg;
+    }
+
+    double length() const {
+        return kind == Kind::Line ? (end - start).norm() : std::abs(sweep) * radius;
+    }
+
+    math::Vector2 point(double s) const {
+        if (kind == Kind::Line)
+            return start + (end - start) * s;
+        double a = angle0 + sweep * s;
+        return math::Vector2{center.x + radius * std::cos(a), center.y + radius * std::sin(a)};
+    }
+};
+
+//A solved waypoint as handed to the planner's callback. q is only valid for
+//the duration of the call.
+struct CartesianWaypoint2d {
+    size_t index;                //0 for the path start, then consecutive
+    size_t segment;              //segment the waypoint lies on
+    double s;                    //parameter on that segment
+    math::Vector2 target;
+    const std::vector<double>& q;
+    IK2dResult result;
+    bool jump;                   //joint step from the previous waypoint still
+                                 //exceeds max_joint_step after refinement
+};
+
+//Totals of one planner run
+struct CartesianPathSummary2d {
+    size_t waypoints = 0;
+    size_t refinements = 0;      //intervals that were split in half
+    size_t jumps = 0;            //waypoints emitted with jump set
+    size_t failed = 0;           //waypoints whose IK did not converge
+    bool stopped = false;        //the callback asked to stop
+};
+
+//Reusable buffers for CartesianPlanner2d::stream: the IK workspace every
+//waypoint is solved in, and the previous waypoint per refinement level.
+//Sized by the first stream; later streams with the same DOF and
+//max_refine_depth run without heap allocation.
+struct CartesianPlannerWorkspace2d {
+    IK2dWorkspace ik;
+    std::vector<double> q_levels; //(max_refine_depth + 1) x dof, row-major
+
+    CartesianPlannerWorkspace2d() = default;
+
+    explicit CartesianPlannerWorkspace2d(const RobotArm2d& arm) : ik(arm) {}
+
+    void resize(size_t dof, int max_refine_depth) {
+        ik.resize(dof);
+        q_levels.resize(static_cast<size_t>(max_refine_depth + 1) * dof);
+    }
+};
+
+//Streaming Cartesian path planner. The tool path is sampled every
+//`resolution` along each segment and every sample is solved with IK2d,
+//warm-started from the previous waypoint. A sample whose solution moves any
+//joint by more than max_joint_step from the previous waypoint is not
+//emitted; its interval is halved instead (up to max_refine_depth times), so
+//the spacing only gets finer where the arm moves fast in joint space.
+//Waypoints are handed to the callback as soon as they are solved, so the
+//first setpoints are available before the rest of the path is planned.
+struct CartesianPlanner2d {
+    double resolution = 0.01;     //max Cartesian spacing between samples
+    double max_joint_step = 0.1;  //rad; larger steps trigger local refinement
+    int max_refine_depth = 6;     //each level halves the local spacing
+
+    //IK2d parameters for every waypoint; the same defaults as IK2d::solve
+    double tol = 1e-6;
+    int max_iters = 100;
+    double alpha = 1.0;
+    double lambda = 0.1;
+    IK2dDamping damping = IK2dDamping::Fixed;
+
+    //Plans along consecutive segments (each starts where the previous one
+    //ends) from the configuration q0, calling emit(const CartesianWaypoint2d&)
+    //for every waypoint in order; emit returns false to stop early. The last
+    //solution is left in ws.ik.q.
+    template <typename F>
+    CartesianPathSummary2d stream(const RobotArm2d& arm,
+                                  const std::vector<CartesianSegment2d>& segments,
+                                  const std::vector<double>& q0,
+                                  CartesianPlannerWorkspace2d& ws,
+                                  F&& emit) const
+    {
+        CartesianPathSummary2d summary;
+        if (segments.empty())
+            return summary;
+
+        if (ws.ik.q.size() != q0.size() ||
+            ws.q_levels.size() != static_cast<size_t>(max_refine_depth + 1) * q0.size())
+            ws.resize(q0.size(), max_refine_depth);
+        if (&q0 != &ws.ik.q)
+            ws.ik.q.assign(q0.begin(), q0.end());
+
+        Run<F> run{*this, arm, ws.ik, ws.q_levels, emit, summary};
+
+        //the path start is emitted as is, there is no previous waypoint to jump from
+        IK2dResult r = IK2d::solve(arm, segments[0].start, ws.ik.q, ws.ik, tol, max_iters, alpha, lambda, damping);
+        if (!run.emit_waypoint(0, 0.0, segments[0].start, r, false))
+            return summary;
+
+        for (size_t k = 0; k < segments.size(); ++k) {
+            const CartesianSegment2d& seg = segments[k];
+            assert(k == 0 || (seg.start - segments[k - 1].end).norm() < 1e-9);
+
+            const size_t steps = std::max<size_t>(1, static_cast<size_t>(std::ceil(seg.length() / resolution)));
+            for (size_t j = 0; j < steps; ++j) {
+                double s0 = static_cast<double>(j) / static_cast<double>(steps);
+                double s1 = static_cast<double>(j + 1) / static_cast<double>(steps);
+                if (!run.advance(seg, k, s0, s1, 0))
+                    return summary;
+            }
+        }
+        return summary;
+    }
+
+    //Collects the whole path; convenience over stream()
+    IK2dPathResult plan(const RobotArm2d& arm,
+                        const std::vector<CartesianSegment2d>& segments,
+                        const std::vector<double>& q0,
+                        CartesianPathSummary2d* summary = nullptr) const
+    {
+        CartesianPlannerWorkspace2d ws(arm);
+        IK2dPathResult out;
+        out.dof = q0.size();
+
+        auto s = stream(arm, segments, q0, ws, [&](const CartesianWaypoint2d& wp) {
+            out.q.insert(out.q.end(), wp.q.begin(), wp.q.end());
+            out.status.push_back(wp.result.status);
+            out.iterations.push_back(wp.result.iterations);
+            out.residuals.push_back(wp.result.residual);
+            return true;
+        });
+        if (summary)
+            *summary = s;
+        return out;
+    }
+
+private:
+    template <typename F>
+    struct Run {
+        const CartesianPlanner2d& planner;
+        const RobotArm2d& arm;
+        IK2dWorkspace& ws;
+        std::vector<double>& q_levels; //previous waypoint per refinement level
+        F& emit;
+        CartesianPathSummary2d& summary;
+
+        //Moves from s0 (solution in ws.q) to s1 on seg, splitting the
+        //interval while the joint step is too large
+        bool advance(const CartesianSegment2d& seg, size_t k, double s0, double s1, int depth) {
+            const size_t N = ws.q.size();
+            double* prev = q_levels.data() + static_cast<size_t>(depth) * N;
+            std::copy(ws.q.begin(), ws.q.end(), prev);
+
+            const math::Vector2 target = seg.point(s1);
+            IK2dResult r = IK2d::solve(arm, target, ws.q, ws, planner.tol, planner.max_iters,
+                                       planner.alpha, planner.lambda, planner.damping);
+
+            double step = 0.0;
+            for (size_t i = 0; i < N; ++i)
+                step = std::max(step, std::abs(ws.q[i] - prev[i]));
+
+            const bool jump = step > planner.max_joint_step;
+            if (jump && depth < planner.max_refine_depth) {
+                ++summary.refinements;
+                std::copy(prev, prev + N, ws.q.begin());
+                double mid = 0.5 * (s0 + s1);
+                return advance(seg, k, s0, mid, depth + 1) && advance(seg, k, mid, s1, depth + 1);
+            }
+
+            return emit_waypoint(k, s1, target, r, jump);
+        }
+
+        bool emit_waypoint(size_t k, double s, const math::Vector2& target,
+                           const IK2dResult& r, bool jump) {
+            CartesianWaypoint2d wp{summary.waypoints, k, s, target, ws.q, r, jump};
+            ++summary.waypoints;
+            if (jump) ++summary.jumps;
+            if (!r.converged()) ++summary.failed;
+
+            if (!emit(static_cast<const CartesianWaypoint2d&>(wp))) {
+                summary.stopped = true;
+                return false;
+            }
+            return true;
+        }
+    };
+};
+
+} // namespace robot
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "math/se2.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace robot {
+
+//Forward kinematics state for one configuration that is updated in place as
+//single joints change. Caches, per joint, the cumulative rotation, the world
+//link angle with its cos/sin, and the joint origin, so an update only touches
+//the chain downstream of the changed joint: O(N - k) for joint k, which is
+//near O(1) for distal joints of long chains.
+//
+//With the RobotArm2d convention (joint i rotates by q1 + ... + qi) changing
+//q_k alone also changes the rotation at every later joint, so set_joint has to
+//recompute the suffix with one sin/cos per link. rotate_joint instead turns
+//the subchain after joint k rigidly (q_k += delta, q_k+1 -= delta), which needs
+//a single sin/cos and rotates the downstream points.
+class IncrementalFK2d {
+public:
+    IncrementalFK2d(const RobotArm2d& arm, const std::vector<double>& q)
+        : link_lengths_(arm.link_lengths) {
+        const size_t N = link_lengths_.size();
+        q_.resize(N);
+        cumulative_.resize(N);
+        theta_.resize(N);
+        cos_.resize(N);
+        sin_.resize(N);
+        joints_.resize(N);
+        reset(q);
+    }
+
+    //full O(N) recomputation
+    void reset(const std::vector<double>& q) {
+        assert(q.size() == link_lengths_.size());
+        q_ = q;
+        recompute_from(0);
+        rigid_updates_ = 0;
+    }
+
+    //sets q_k and recomputes joints k+1.. and the end effector
+    void set_joint(size_t k, double value) {
+        assert(k < q_.size());
+        q_[k] = value;
+        recompute_from(k);
+    }
+
+    //rotates links k.. rigidly about joint k by delta
+    void rotate_joint(size_t k, double delta) {
+        using math::Vector2;
+
+        const size_t N = q_.size();
+        assert(k < N);
+
+        q_[k] += delta;
+        if (k + 1 < N)
+            q_[k + 1] -= delta;
+        cumulative_[k] += delta; //later cumulative rotations are unchanged
+
+        //repeated rotations accumulate rounding in the cached cos/sin and
+        //points, so every so often rebuild the whole chain exactly
+        if (++rigid_updates_ >= kRefreshInterval) {
+            rigid_updates_ = 0;
+            recompute_from(0);
+            return;
+        }
+
+        const double cd = std::cos(delta);
+        const double sd = std::sin(delta);
+        const Vector2 pivot = joints_[k];
+
+        for (size_t i = k; i < N; ++i) {
+            theta_[i] += delta;
+            double c = cos_[i] * cd - sin_[i] * sd;
+            double s = sin_[i] * cd + cos_[i] * sd;
+            cos_[i] = c;
+            sin_[i] = s;
+        }
+
+        for (size_t i = k + 1; i < N; ++i)
+            joints_[i] = rotate_about(joints_[i], pivot, cd, sd);
+        end_ = rotate_about(end_, pivot, cd, sd);
+    }
+
+    const std::vector<double>& q() const { return q_; }
+
+    //world-frame joint origins, as RobotArm2d::joint_positions
+    const std::vector<math::Vector2>& joint_positions() const { return joints_; }
+
+    math::Vector2 end_effector() const { return end_; }
+
+    //end-effector pose, as RobotArm2d::forward_kinematics
+    math::SE2 pose() const {
+        if (q_.empty())
+            return math::SE2();
+        double c = cos_.back();
+        double s = sin_.back();
+        return math::SE2(math::Matrix2(c, -s,
+                                       s, c), end_);
+    }
+
+private:
+    static constexpr int kRefreshInterval = 256;
+
+    static math::Vector2 rotate_about(const math::Vector2& p, const math::Vector2& pivot,
+                                      double c, double s) {
+        double dx = p.x - pivot.x;
+        double dy = p.y - pivot.y;
+        return math::Vector2{
+            pivot.x + c * dx - s * dy,
+            pivot.y + s * dx + c * dy
+        };
+    }
+
+    void recompute_from(size_t k) {
+        using math::Vector2;
+
+        const size_t N = q_.size();
+
+        double cumulative = (k > 0) ? cumulative_[k - 1] : 0.0;
+        double theta = (k > 0) ? theta_[k - 1] : 0.0;
+        Vector2 p = (k > 0)
+            ? Vector2{joints_[k - 1].x + link_lengths_[k - 1] * cos_[k - 1],
+                      joints_[k - 1].y + link_lengths_[k - 1] * sin_[k - 1]}
+            : Vector2{0.0, 0.0};
+
+        for (size_t i = k; i < N; ++i) {
+            cumulative += q_[i];
+            theta += cumulative;
+
+            cumulative_[i] = cumulative;
+            theta_[i] = theta;
+            cos_[i] = std::cos(theta);
+            sin_[i] = std::sin(theta);
+            joints_[i] = p;
+
+            p.x += link_lengths_[i] * cos_[i];
+            p.y += link_lengths_[i] * sin_[i];
+        }
+
+        end_ = p;
+    }
+
+    std::vector<double> link_lengths_;
+    std::vector<double> q_;
+    std::vector<double> cumulative_; //q1 + ... + qi
+    std::vector<double> theta_;      //world angle of link i
+    std::vector<double> cos_, sin_;
+    std::vector<math::Vector2> joints_;
+    math::Vector2 end_;
+    int rigid_updates_ = 0;
+};
+
+} // namespace robot
@@ -1,14 +1,64 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <utility>
 #include <vector>
 #include <cmath>
 
 #include "robot/robot_arm_2d.hpp"
+#include "robot/robot_arm_2d_n.hpp"
+#include "robot/ik_2d_analytic.hpp"
+#include "robot/ik_2d_telemetry.hpp"
 #include "robot/jacobian_2d.hpp"
 #include "math/se2.hpp"
 
 namespace robot {
 
+//How IK2d picks the damping and step length of each iteration
+enum class IK2dDamping {
+    Fixed,   //lambda and alpha as given, every iteration
+    Adaptive //Levenberg-Marquardt: lambda and alpha are only starting values
+};
+
+//Reusable buffers for IK2d::solve. Sized once per arm; after the first solve
+//every further solve on an arm of the same DOF runs without heap allocation.
+struct IK2dWorkspace {
+    std::vector<double> q;              //current / final joint angles
+    std::vector<math::Vector2> joints;  //joint origins
+    std::vector<math::Vector2> J;       //Jacobian columns
+    std::vector<double> q_trial;        //candidate step (adaptive damping)
+
+    //optional: when set, the solve stops at the next iteration boundary
+    const std::atomic<bool>* cancel = nullptr;
+
+    //optional: receives every result, with its wall time
+    IK2dTelemetry* telemetry = nullptr;
+
+    IK2dWorkspace() = default;
+
+    explicit IK2dWorkspace(const RobotArm2d& arm) {
+        resize(arm.link_lengths.size());
+    }
+
+    void resize(size_t N) {
+        q.resize(N);
+        joints.resize(N);
+        J.resize(N);
+        q_trial.resize(N);
+    }
+};
+
+//Outcome of the fixed-DOF IK2d::solve: the same report as the workspace
+//solve, with the joint angles returned alongside since there is no workspace
+template <std::size_t N>
+struct IK2dResultN : IK2dResult {
+    std::array<double, N> q{};
+};
+
 struct IK2d {
     static std::vector<double>
     solve(const RobotArm2d& arm,
@@ -17,56 +67,127 @@ struct IK2d {
           double tol = 1e-6,
           int max_iters = 100,
           double alpha = 1.0,
-          double lambda = 0.1)
+          double lambda = 0.1,
+          IK2dDamping damping = IK2dDamping::Fixed)
     {
-        std::vector<double> q = q0;
-        size_t N = q.size();
+        IK2dWorkspace ws(arm);
+        solve(arm, target, q0, ws, tol, max_iters, alpha, lambda, damping);
+        return ws.q;
+    }
 
-        for (int iter = 0; iter < max_iters; ++iter) {
+    //Workspace variant: the solution is left in ws.q; the result reports why
+    //and after how many iterations the solve stopped.
+    //2-link arms, and 3-link arms whose wrist can reach the target with the last
+    //link angle of q0, are solved in closed form (IK2dAnalytic) using the branch
+    //closest to q0; everything else runs the iterative solver.
+    static IK2dResult
+    solve(const RobotArm2d& arm,
+          const math::Vector2& target,
+          const std::vector<double>& q0,
+          IK2dWorkspace& ws,
+          double tol = 1e-6,
+          int max_iters = 100,
+          double alpha = 1.0,
+          double lambda = 0.1,
+          IK2dDamping damping = IK2dDamping::Fixed)
+    {
+        assert(q0.size() == arm.link_lengths.size());
+
+        size_t N = q0.size();
+        if (ws.q.size() != N)
+            ws.resize(N);
+
+        auto t0 = start(ws);
 
-            auto T = arm.forward_kinematics(q);
+        //solve_closest reads q0 fully before writing, so q0 may alias ws.q
+        if (IK2dAnalytic::solve_closest(arm.link_lengths.data(), N, target, q0.data(), ws.q.data())) {
+            auto T = arm.kinematics(ws.q, ws.joints, ws.J);
             math::Vector2 p = T * math::Vector2{0.0, 0.0};
 
+            IK2dResult result;
+            result.iterations = 0;
+            result.residual = (target - p).norm();
+            result.status = result.residual < tol ? IK2dStatus::Converged : IK2dStatus::Unreachable;
+            return finish(ws, result, t0);
+        }
+
+        return solve_iterative(arm, target, q0, ws, tol, max_iters, alpha, lambda, damping);
+    }
+
+    //Damped least-squares iteration without the closed-form dispatch
+    static IK2dResult
+    solve_iterative(const RobotArm2d& arm,
+                    const math::Vector2& target,
+                    const std::vector<double>& q0,
+                    IK2dWorkspace& ws,
+                    double tol = 1e-6,
+                    int max_iters = 100,
+                    double alpha = 1.0,
+                    double lambda = 0.1,
+                    IK2dDamping damping = IK2dDamping::Fixed)
+    {
+        //the kernel reads one link length per joint angle
+        assert(q0.size() == arm.link_lengths.size());
+
+        if (damping == IK2dDamping::Adaptive)
+            return solve_adaptive(arm, target, q0, ws, tol, max_iters, alpha, lambda);
+
+        auto t0 = start(ws);
+
+        size_t N = q0.size();
+        if (ws.q.size() != N)
+            ws.resize(N);
+
+        //q0 may be ws.q itself, which warm-starts from the previous solution
+        std::vector<double>& q = ws.q;
+        if (&q0 != &q)
+            q.assign(q0.begin(), q0.end());
+
+        IK2dResult result;
+
+        //max_iters updates; the error is evaluated once more after the last
+        //one so that the residual always describes the returned q
+        for (int iter = 0; ; ++iter) {
+
+            //one fused pass: end-effector position and dp/dq columns
+            math::Vector2 p = tip_and_jacobian(arm, q, ws.J);
+
             double ex = target.x - p.x;
             double ey = target.y - p.y;
 
-            if (std::sqrt(ex*ex + ey*ey) < tol)
-                return q;
-
-            //previous incompatible code    
-            //auto J = Jacobian2d::compute(arm.link_lengths, q);
+            result.residual = std::sqrt(ex*ex + ey*ey);
+            if (result.residual < tol) {
+                result.status = IK2dStatus::Converged;
+                return finish(ws, result, t0);
+            }
+            if (iter >= max_iters) {
+                result.status = IK2dStatus::MaxIterations;
+                return finish(ws, result, t0);
+            }
+            if (ws.cancel && ws.cancel->load(std::memory_order_relaxed)) {
+                result.status = IK2dStatus::Cancelled;
+                return finish(ws, result, t0);
+            }
 
-            //new compatible code
-            auto Jcols = arm.jacobian(q);
+            //2xN Jacobian as N columns, from the suffix-sum kernel shared with
+            //Jacobian2d (columns with respect to the joint angles themselves)
+            const std::vector<math::Vector2>& J = ws.J;
 
-            //convert to 2xN matrix
-            std::vector<std::vector<double>> J(2, std::vector<double>(N));
-            for (size_t i = 0; i < N; ++i) {
-                J[0][i] = Jcols[i].x;
-                J[1][i] = Jcols[i].y;
-            }
-
-            /* debugging
-            if (iter == 0) { 
-                std::cout << "J row 0: "; 
-                for (size_t i = 0; i < N; ++i) std::cout << J[0][i] << " "; 
-                std::cout << "\nJ row 1: "; 
-                for (size_t i = 0; i < N; ++i) std::cout << J[1][i] << " "; 
-                std::cout << "\n"; 
-            }*/
             double a = 0.0, b = 0.0, c = 0.0;
             for (size_t i = 0; i < N; ++i) {
-                a += J[0][i] * J[0][i];
-                b += J[0][i] * J[1][i];
-                c += J[1][i] * J[1][i];
+                a += J[i].x * J[i].x;
+                b += J[i].x * J[i].y;
+                c += J[i].y * J[i].y;
             }
 
             a += lambda * lambda;
             c += lambda * lambda;
 
             double det = a * c - b * b;
-            if (std::abs(det) < 1e-12)
-                break;
+            if (std::abs(det) < 1e-12) {
+                result.status = IK2dStatus::Singular;
+                return finish(ws, result, t0);
+            }
 
             // Inverse of 2×2 matrix
             double inv00 =  c / det;
@@ -74,20 +195,247 @@ struct IK2d {
             double inv10 = -b / det;
             double inv11 =  a / det;
 
-            std::vector<double> dq(N, 0.0);
+            double v0 = inv00 * ex + inv01 * ey;
+            double v1 = inv10 * ex + inv11 * ey;
+
+            for (size_t i = 0; i < N; ++i)
+                q[i] += alpha * (J[i].x * v0 + J[i].y * v1);
+
+            result.iterations = iter + 1;
+        }
+    }
+
+    //Fixed-DOF variant with the same closed-form dispatch as above
+    template <std::size_t N>
+    static IK2dResultN<N>
+    solve(const RobotArm2dN<N>& arm,
+          const math::Vector2& target,
+          const std::array<double, N>& q0,
+          double tol = 1e-6,
+          int max_iters = 100,
+          double alpha = 1.0,
+          double lambda = 0.1)
+    {
+        if constexpr (N == 2 || N == 3) {
+            IK2dResultN<N> result;
+            if (IK2dAnalytic::solve_closest(arm.link_lengths.data(), N, target, q0.data(), result.q.data())) {
+                math::Vector2 p = arm.forward_kinematics(result.q) * math::Vector2{0.0, 0.0};
+
+                result.iterations = 0;
+                result.residual = (target - p).norm();
+                result.status = result.residual < tol ? IK2dStatus::Converged : IK2dStatus::Unreachable;
+                return result;
+            }
+        }
+        return solve_iterative(arm, target, q0, tol, max_iters, alpha, lambda);
+    }
+
+    //Fixed-DOF iteration with all state on the stack; same stopping rules as
+    //the workspace solve, without the cancel flag and telemetry
+    template <std::size_t N>
+    static IK2dResultN<N>
+    solve_iterative(const RobotArm2dN<N>& arm,
+                    const math::Vector2& target,
+                    const std::array<double, N>& q0,
+                    double tol = 1e-6,
+                    int max_iters = 100,
+                    double alpha = 1.0,
+                    double lambda = 0.1)
+    {
+        IK2dResultN<N> result;
+        std::array<double, N>& q = result.q;
+        q = q0;
+        std::array<math::Vector2, N> J;
+
+        for (int iter = 0; ; ++iter) {
+
+            //end-effector position and dp/dq columns
+            const Jacobian2d::Tip tip = Jacobian2d::kernel(arm.link_lengths.data(), q.data(), N,
+                                                           JointAngles::CumulativeDq,
+                                                           &J[0].x, &J[0].y, 2);
+
+            double ex = target.x - tip.p.x;
+            double ey = target.y - tip.p.y;
+
+            result.residual = std::sqrt(ex*ex + ey*ey);
+            if (result.residual < tol) {
+                result.status = IK2dStatus::Converged;
+                return result;
+            }
+            if (iter >= max_iters) {
+                result.status = IK2dStatus::MaxIterations;
+                return result;
+            }
+
+            double a = 0.0, b = 0.0, c = 0.0;
+            for (std::size_t i = 0; i < N; ++i) {
+                a += J[i].x * J[i].x;
+                b += J[i].x * J[i].y;
+                c += J[i].y * J[i].y;
+            }
+
+            a += lambda * lambda;
+            c += lambda * lambda;
+
+            double det = a * c - b * b;
+            if (std::abs(det) < 1e-12) {
+                result.status = IK2dStatus::Singular;
+                return result;
+            }
+
+            double inv00 =  c / det;
+            double inv01 = -b / det;
+            double inv10 = -b / det;
+            double inv11 =  a / det;
 
             double v0 = inv00 * ex + inv01 * ey;
             double v1 = inv10 * ex + inv11 * ey;
 
+            for (std::size_t i = 0; i < N; ++i)
+                q[i] += alpha * (J[i].x * v0 + J[i].y * v1);
+
+            result.iterations = iter + 1;
+        }
+    }
+
+private:
+    //Levenberg-Marquardt with backtracking, on the same dp/dq Jacobian as the
+    //fixed mode.
+    //Each step is compared against the reduction predicted by the linear model
+    //(rho = actual / predicted): the step length is halved while rho is poor,
+    //and the damping is lowered after good steps and raised after poor ones.
+    //A rejected step leaves q unchanged, so the next iteration reuses its end
+    //effector and Jacobian instead of evaluating them again.
+    static IK2dResult
+    solve_adaptive(const RobotArm2d& arm,
+                   const math::Vector2& target,
+                   const std::vector<double>& q0,
+                   IK2dWorkspace& ws,
+                   double tol,
+                   int max_iters,
+                   double alpha,
+                   double lambda)
+    {
+        constexpr double kMinDamping = 1e-12;
+        constexpr double kMaxDamping = 1e12;
+        constexpr int kBacktracks = 4;
+
+        auto t0 = start(ws);
+
+        size_t N = q0.size();
+        if (ws.q.size() != N)
+            ws.resize(N);
+
+        std::vector<double>& q = ws.q;
+        if (&q0 != &q)
+            q.assign(q0.begin(), q0.end());
+
+        double mu = lambda * lambda;
+        double step0 = std::min(alpha, 1.0);
+
+        IK2dResult result;
+        math::Vector2 p;
+        bool stale = true; //p and ws.J need evaluating at q
+
+        for (int iter = 0; ; ++iter) {
+
+            if (stale)
+                p = tip_and_jacobian(arm, q, ws.J);
+
+            double ex = target.x - p.x;
+            double ey = target.y - p.y;
+            double err2 = ex*ex + ey*ey;
+
+            result.residual = std::sqrt(err2);
+            if (result.residual < tol) {
+                result.status = IK2dStatus::Converged;
+                return finish(ws, result, t0);
+            }
+            if (iter >= max_iters) {
+                result.status = IK2dStatus::MaxIterations;
+                return finish(ws, result, t0);
+            }
+            if (ws.cancel && ws.cancel->load(std::memory_order_relaxed)) {
+                result.status = IK2dStatus::Cancelled;
+                return finish(ws, result, t0);
+            }
+            if (mu > kMaxDamping) {
+                result.status = IK2dStatus::Singular;
+                return finish(ws, result, t0);
+            }
+
+            const std::vector<math::Vector2>& Jq = ws.J;
+
+            double a = 0.0, b = 0.0, c = 0.0;
             for (size_t i = 0; i < N; ++i) {
-                dq[i] = alpha * (J[0][i] * v0 + J[1][i] * v1);
+                a += Jq[i].x * Jq[i].x;
+                b += Jq[i].x * Jq[i].y;
+                c += Jq[i].y * Jq[i].y;
             }
 
-            for (size_t i = 0; i < N; ++i)
-                q[i] += dq[i];
+            //(Jq Jq^T + mu I) v = e, dq = Jq^T v; Jq dq = (Jq Jq^T) v
+            double a_mu = a + mu;
+            double c_mu = c + mu;
+            double det = a_mu * c_mu - b * b;
+            double v0 = ( c_mu * ex - b * ey) / det;
+            double v1 = (-b * ex + a_mu * ey) / det;
+            double dx = a * v0 + b * v1;
+            double dy = b * v0 + c * v1;
+
+            double rho = 0.0;
+            double t = step0;
+            for (int k = 0; k <= kBacktracks; ++k, t *= 0.5) {
+                for (size_t i = 0; i < N; ++i)
+                    ws.q_trial[i] = q[i] + t * (Jq[i].x * v0 + Jq[i].y * v1);
+
+                math::Vector2 pt = arm.forward_kinematics(ws.q_trial) * math::Vector2{0.0, 0.0};
+                double tx = target.x - pt.x;
+                double ty = target.y - pt.y;
+
+                double rx = ex - t * dx;
+                double ry = ey - t * dy;
+                double predicted = err2 - (rx*rx + ry*ry);
+                double actual = err2 - (tx*tx + ty*ty);
+
+                rho = (predicted > 0.0) ? actual / predicted : -1.0;
+                if (rho > 0.25)
+                    break;
+            }
+
+            stale = rho > 0.25;
+            if (stale) {
+                std::swap(ws.q, ws.q_trial);
+                if (rho > 0.75)
+                    mu = std::max(mu / 3.0, kMinDamping);
+            } else {
+                mu = std::max(mu, kMinDamping) * 4.0;
+            }
+
+            result.iterations = iter + 1;
         }
+    }
+
+    //End-effector position and the true dp/dq columns: RobotArm2d::kinematics
+    //returns dp/dc, which is not the direction a step in q moves the tip
+    static math::Vector2 tip_and_jacobian(const RobotArm2d& arm, const std::vector<double>& q,
+                                          std::vector<math::Vector2>& J) noexcept {
+        assert(q.size() == arm.link_lengths.size() && J.size() >= q.size());
+        return Jacobian2d::kernel(arm.link_lengths.data(), q.data(), q.size(),
+                                  JointAngles::CumulativeDq, &J.data()->x, &J.data()->y, 2).p;
+    }
 
-        return q;
+    //the clock is only read when a telemetry sink is attached
+    static std::chrono::steady_clock::time_point start(const IK2dWorkspace& ws) {
+        return ws.telemetry ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+    }
+
+    static IK2dResult finish(IK2dWorkspace& ws, IK2dResult& result,
+                             std::chrono::steady_clock::time_point t0) {
+        if (ws.telemetry) {
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            ws.telemetry->record(result);
+        }
+        return result;
     }
 };
 
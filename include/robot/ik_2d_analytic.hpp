@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "robot/robot_arm_2d.hpp"
+#include "math/vector2.hpp"
+
+namespace robot {
+
+//Closed-form solution branches for a 2- or 3-link arm. Joint angles follow
+//the RobotArm2d convention (joint i rotates by q1 + ... + qi relative to the
+//previous link); only the first dof entries of each branch are used.
+struct IK2dBranches {
+    std::array<std::array<double, 3>, 2> q{}; //[0] elbow angle > 0, [1] elbow angle < 0
+    size_t dof = 0;
+    size_t count = 0;   //number of distinct branches
+    bool exact = false; //false if out of reach: the single branch points at the target
+};
+
+//Constant-time IK for planar 2R arms (law of cosines) and 3R arms with a
+//prescribed world-frame angle psi of the last link.
+struct IK2dAnalytic {
+    //2R: all branches reaching target with links L1, L2
+    static IK2dBranches solve(double L1, double L2, const math::Vector2& target) {
+        IK2dBranches out;
+        out.dof = 2;
+
+        //relative link angles (a, b) of a conventional 2R arm
+        double ab[2][2];
+        size_t n = solve_relative(L1, L2, target, ab, out.exact);
+
+        for (size_t k = 0; k < n; ++k) {
+            out.q[k][0] = ab[k][0];
+            out.q[k][1] = ab[k][1] - ab[k][0];
+        }
+        out.count = n;
+        return out;
+    }
+
+    //3R: all branches reaching target with the last link at world angle psi
+    static IK2dBranches solve(double L1, double L2, double L3,
+                              const math::Vector2& target, double psi) {
+        IK2dBranches out;
+        out.dof = 3;
+
+        math::Vector2 wrist{
+            target.x - L3 * std::cos(psi),
+            target.y - L3 * std::sin(psi)
+        };
+
+        double ab[2][2];
+        size_t n = solve_relative(L1, L2, wrist, ab, out.exact);
+
+        for (size_t k = 0; k < n; ++k) {
+            double a = ab[k][0];
+            double b = ab[k][1];
+            double c = psi - a - b;
+            out.q[k][0] = a;
+            out.q[k][1] = b - a;
+            out.q[k][2] = c - b;
+        }
+        out.count = n;
+        return out;
+    }
+
+    static IK2dBranches solve(const RobotArm2d& arm, const math::Vector2& target) {
+        return solve(arm.link_lengths[0], arm.link_lengths[1], target);
+    }
+
+    static IK2dBranches solve(const RobotArm2d& arm, const math::Vector2& target, double psi) {
+        return solve(arm.link_lengths[0], arm.link_lengths[1], arm.link_lengths[2], target, psi);
+    }
+
+    //Writes into q the branch closest to q0, with every joint shifted by a
+    //multiple of 2*pi to lie within pi of q0 so that consecutive solves stay
+    //continuous. For 3 links psi is taken from the last link angle at q0.
+    //Returns false (leaving q untouched) when the arm has another link count
+    //or, for 3 links, the wrist cannot reach; callers then iterate instead.
+    static bool solve_closest(const double* L, size_t N,
+                              const math::Vector2& target,
+                              const double* q0, double* q) {
+        IK2dBranches br;
+        if (N == 2) {
+            br = solve(L[0], L[1], target);
+        } else if (N == 3) {
+            //world angle of link 3 is 3*q1 + 2*q2 + q3
+            double psi = 3.0 * q0[0] + 2.0 * q0[1] + q0[2];
+            br = solve(L[0], L[1], L[2], target, psi);
+            if (!br.exact)
+                return false;
+        } else {
+            return false;
+        }
+
+        size_t best = 0;
+        double best_dist = 0.0;
+        for (size_t k = 0; k < br.count; ++k) {
+            double dist = 0.0;
+            for (size_t i = 0; i < N; ++i) {
+                double d = std::remainder(br.q[k][i] - q0[i], 2.0 * M_PI);
+                dist += d * d;
+            }
+            if (k == 0 || dist < best_dist) {
+                best = k;
+                best_dist = dist;
+            }
+        }
+
+        for (size_t i = 0; i < N; ++i)
+            q[i] = q0[i] + std::remainder(br.q[best][i] - q0[i], 2.0 * M_PI);
+        return true;
+    }
+
+private:
+    //Conventional 2R solution: ab[k] = {a, b} with link 1 at world angle a and
+    //link 2 at a + b. Returns the number of branches.
+    static size_t solve_relative(double L1, double L2, const math::Vector2& target,
+                                 double ab[2][2], bool& exact) {
+        double r2 = target.x * target.x + target.y * target.y;
+        double r = std::sqrt(r2);
+        double heading = std::atan2(target.y, target.x);
+
+        //beyond full stretch: point straight at the target
+        if (r >= L1 + L2) {
+            exact = (r == L1 + L2);
+            ab[0][0] = heading;
+            ab[0][1] = 0.0;
+            return 1;
+        }
+
+        //inside the inner dead zone: fold back, the shorter link toward the base
+        if (r <= std::abs(L1 - L2)) {
+            exact = (r == std::abs(L1 - L2));
+            ab[0][0] = (L1 >= L2) ? heading : heading + M_PI;
+            ab[0][1] = M_PI;
+            return 1;
+        }
+
+        exact = true;
+
+        double cos_b = (r2 - L1 * L1 - L2 * L2) / (2.0 * L1 * L2);
+        cos_b = std::max(-1.0, std::min(1.0, cos_b));
+        double b = std::acos(cos_b);
+
+        for (size_t k = 0; k < 2; ++k) {
+            double bk = (k == 0) ? b : -b;
+            ab[k][0] = heading - std::atan2(L2 * std::sin(bk), L1 + L2 * std::cos(bk));
+            ab[k][1] = bk;
+        }
+        return 2;
+    }
+};
+
+} // namespace robot
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "robot/ik_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+#include "math/vector2.hpp"
+
+namespace robot {
+
+//Outcome of one seed in a multi-start solve
+struct IK2dSeedStats {
+    IK2dStatus status = IK2dStatus::Cancelled;
+    int iterations = 0;
+    double residual = std::numeric_limits<double>::infinity();
+
+    bool converged() const { return status == IK2dStatus::Converged; }
+    //stopped (or never started) because another seed converged
+    bool cancelled() const { return status == IK2dStatus::Cancelled; }
+};
+
+struct IK2dMultiStartResult {
+    std::vector<double> q;      //best solution found
+    size_t best_seed = 0;
+    bool converged = false;
+    std::vector<IK2dSeedStats> seeds;
+};
+
+//Runs IK2d::solve from several seeds across a thread pool. The first seed
+//to converge raises a shared flag that makes the remaining solves return at
+//their next iteration and skips seeds that have not started yet.
+struct IK2dMultiStart {
+    static IK2dMultiStartResult
+    solve(const RobotArm2d& arm,
+          const math::Vector2& target,
+          const std::vector<std::vector<double>>& seeds,
+          util::ThreadPool& pool,
+          double tol = 1e-6,
+          int max_iters = 100,
+          double alpha = 1.0,
+          double lambda = 0.1)
+    {
+        const size_t N = arm.link_lengths.size();
+        const size_t K = seeds.size();
+
+        IK2dMultiStartResult result;
+        result.seeds.resize(K);
+
+        std::vector<double> solutions(K * N, 0.0);
+        std::vector<IK2dWorkspace> workspaces(pool.size(), IK2dWorkspace(arm));
+        std::atomic<bool> solved{false};
+
+        for (auto& ws : workspaces)
+            ws.cancel = &solved;
+
+        pool.run(K, [&](size_t k, size_t slot) {
+            IK2dSeedStats& stats = result.seeds[k];
+
+            //skipped seeds keep the default Cancelled status
+            if (solved.load(std::memory_order_relaxed))
+                return;
+
+            IK2dWorkspace& ws = workspaces[slot];
+            IK2dResult r = IK2d::solve(arm, target, seeds[k], ws, tol, max_iters, alpha, lambda);
+
+            stats.status = r.status;
+            stats.iterations = r.iterations;
+            stats.residual = r.residual;
+
+            if (stats.converged())
+                solved.store(true, std::memory_order_relaxed);
+
+            std::copy(ws.q.begin(), ws.q.end(), solutions.begin() + k * N);
+        });
+
+        //prefer converged seeds, then the smallest residual
+        size_t best = K;
+        for (size_t k = 0; k < K; ++k) {
+            const auto& s = result.seeds[k];
+            if (!std::isfinite(s.residual)) //never started
+                continue;
+            if (best == K ||
+                (s.converged() && !result.seeds[best].converged()) ||
+                (s.converged() == result.seeds[best].converged() && s.residual < result.seeds[best].residual))
+                best = k;
+        }
+
+        if (best < K) {
+            result.best_seed = best;
+            result.converged = result.seeds[best].converged();
+            result.q.assign(solutions.begin() + best * N, solutions.begin() + (best + 1) * N);
+        }
+
+        return result;
+    }
+
+    //Convenience overload: q0 followed by num_seeds - 1 uniformly random seeds
+    static IK2dMultiStartResult
+    solve(const RobotArm2d& arm,
+          const math::Vector2& target,
+          const std::vector<double>& q0,
+          size_t num_seeds,
+          util::ThreadPool& pool,
+          unsigned rng_seed = 0,
+          double tol = 1e-6,
+          int max_iters = 100,
+          double alpha = 1.0,
+          double lambda = 0.1)
+    {
+        std::mt19937 rng(rng_seed);
+        std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+        std::vector<std::vector<double>> seeds;
+        seeds.reserve(num_seeds);
+        if (num_seeds > 0)
+            seeds.push_back(q0);
+        while (seeds.size() < num_seeds) {
+            std::vector<double> q(q0.size());
+            for (auto& v : q) v = angle(rng);
+            seeds.push_back(std::move(q));
+        }
+
+        return solve(arm, target, seeds, pool, tol, max_iters, alpha, lambda);
+    }
+};
+
+} // namespace robot
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "robot/ik_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+#include "math/vector2.hpp"
+
+namespace robot {
+
+//Per-target IK solutions along a Cartesian path
+struct IK2dPathResult {
+    size_t dof = 0;
+    std::vector<double> q;          //size() x dof, row-major
+    std::vector<IK2dStatus> status; //outcome of each solve
+    std::vector<int> iterations;    //joint updates used for each target
+    std::vector<double> residuals;  //end-effector error at each solution
+
+    size_t size() const { return iterations.size(); }
+
+    const double* config(size_t i) const { return q.data() + i * dof; }
+
+    void resize(size_t count, size_t N) {
+        dof = N;
+        q.resize(count * N);
+        status.resize(count);
+        iterations.resize(count);
+        residuals.resize(count);
+    }
+};
+
+//IK over a sequence of closely spaced targets. Each target is warm-started
+//from the previous solution, so after the first target most solves take only
+//a few iterations.
+struct IK2dPath {
+    static IK2dPathResult
+    solve(const RobotArm2d& arm,
+          const std::vector<math::Vector2>& targets,
+          const std::vector<double>& q0,
+          double tol = 1e-6,
+          int max_iters = 100,
+          double alpha = 1.0,
+          double lambda = 0.1)
+    {
+        IK2dWorkspace ws(arm);
+        IK2dPathResult out;
+        solve(arm, targets.data(), targets.size(), q0, ws, out, tol, max_iters, alpha, lambda);
+        return out;
+    }
+
+    //Core loop over targets[0, count). Reuses ws and out, so repeated calls on
+    //paths of the same length do not allocate.
+    static void
+    solve(const RobotArm2d& arm,
+          const math::Vector2* targets,
+          size_t count,
+          const std::vector<double>& q0,
+          IK2dWorkspace& ws,
+          IK2dPathResult& out,
+          double tol = 1e-6,
+          int max_iters = 100,
+          double alpha = 1.0,
+          double lambda = 0.1)
+    {
+        const size_t N = q0.size();
+        out.resize(count, N);
+
+        //ws.q holds the previous solution, which seeds the next solve
+        ws.q.assign(q0.begin(), q0.end());
+
+        for (size_t i = 0; i < count; ++i) {
+            IK2dResult r = IK2d::solve(arm, targets[i], ws.q, ws, tol, max_iters, alpha, lambda);
+            record(ws, r, out, i);
+        }
+    }
+
+    //Splits the path into chunks of chunk_size targets that are solved
+    //concurrently, each cold-started from q0. Chunk boundaries are then
+    //stitched in order: the first targets of every chunk are re-solved
+    //warm-started from the end of the previous chunk until the re-solved
+    //configuration agrees with the parallel one to within stitch_tol (max
+    //joint difference). Non-redundant arms usually agree after one or two
+    //targets; on redundant arms the chunk may be re-solved to its end.
+    static IK2dPathResult
+    solve_chunked(const RobotArm2d& arm,
+                  const std::vector<math::Vector2>& targets,
+                  const std::vector<double>& q0,
+                  util::ThreadPool& pool,
+                  size_t chunk_size = 64,
+                  double stitch_tol = 1e-3,
+                  double tol = 1e-6,
+                  int max_iters = 100,
+                  double alpha = 1.0,
+                  double lambda = 0.1)
+    {
+        const size_t N = q0.size();
+        const size_t count = targets.size();
+        chunk_size = std::max<size_t>(1, chunk_size);
+        const size_t chunks = (count + chunk_size - 1) / chunk_size;
+
+        IK2dPathResult out;
+        out.resize(count, N);
+
+        std::vector<IK2dWorkspace> workspaces(pool.size(), IK2dWorkspace(arm));
+
+        pool.run(chunks, [&](size_t c, size_t slot) {
+            IK2dWorkspace& ws = workspaces[slot];
+            const size_t begin = c * chunk_size;
+            const size_t end = std::min(count, begin + chunk_size);
+
+            ws.q.assign(q0.begin(), q0.end());
+            for (size_t i = begin; i < end; ++i) {
+                IK2dResult r = IK2d::solve(arm, targets[i], ws.q, ws, tol, max_iters, alpha, lambda);
+                record(ws, r, out, i);
+            }
+        });
+
+        IK2dWorkspace& ws = workspaces[0];
+        for (size_t c = 1; c < chunks; ++c) {
+            const size_t begin = c * chunk_size;
+            const size_t end = std::min(count, begin + chunk_size);
+
+            ws.q.assign(out.config(begin - 1), out.config(begin - 1) + N);
+            for (size_t i = begin; i < end; ++i) {
+                IK2dResult r = IK2d::solve(arm, targets[i], ws.q, ws, tol, max_iters, alpha, lambda);
+
+                double diff = 0.0;
+                for (size_t j = 0; j < N; ++j)
+                    diff = std::max(diff, std::abs(ws.q[j] - out.config(i)[j]));
+
+                record(ws, r, out, i);
+                if (diff <= stitch_tol)
+                    break;
+            }
+        }
+
+        return out;
+    }
+
+private:
+    static void record(const IK2dWorkspace& ws, const IK2dResult& r,
+                       IK2dPathResult& out, size_t i) {
+        std::copy(ws.q.begin(), ws.q.end(), out.q.begin() + i * out.dof);
+        out.status[i] = r.status;
+        out.iterations[i] = r.iterations;
+        out.residuals[i] = r.residual;
+    }
+};
+
+} // namespace robot
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "robot/jacobian_2d.hpp"
+#include "robot/robot_arm_2d_n.hpp"
+#include "math/vector2.hpp"
+
+namespace robot {
+
+//Outcome of one IK2dStep tick
+enum class IK2dStepStatus {
+    Converged, //error at q below tol; q was left unchanged
+    Stepped,   //q moved towards the target; run(): the budget was used up
+    Singular   //damped J * J^T had |det| < 1e-12; q was left unchanged
+};
+
+//Everything an IK2dStep tick reads and writes. Fixed size and owned by the
+//caller, so a tick never touches the heap; keep one per servo loop and feed
+//it the latest target every tick.
+template <std::size_t N>
+struct IK2dStepState {
+    std::array<double, N> q{};           //current joint angles, updated in place
+    std::array<math::Vector2, N> J{};    //scratch: dp/dq columns
+    double residual = INFINITY;          //end-effector error at q before the last update
+    uint64_t steps = 0;                  //updates applied since construction
+};
+
+//Per-tick limits for IK2dStep::run. The tick always applies at least one
+//update; further ones are taken while max_steps allows and, if a time budget
+//is set, while the next update is expected to finish within it (the estimate
+//is the slowest update seen so far in this tick).
+struct IK2dStepBudget {
+    int max_steps = 1;
+    std::chrono::nanoseconds time{0}; //0 means no wall-clock limit
+};
+
+//Hard real-time damped least-squares IK for fixed-DOF arms: bounded work,
+//no allocation, noexcept. One update costs one call of the Jacobian2d
+//suffix-sum kernel for the true dp/dq columns (N sin/cos, two O(N) suffix
+//passes) and a closed-form 2x2 solve:
+//  q += alpha * J^T (J J^T + lambda^2 I)^-1 (target - p)
+//Unlike IK2d::solve there is no iteration loop to convergence and no closed-
+//form dispatch: the caller runs one tick per control period and the state
+//converges over consecutive ticks while tracking a moving target.
+struct IK2dStep {
+    double tol = 1e-6;
+    double alpha = 1.0;
+    double lambda = 0.1;
+
+    //Exactly one evaluation and at most one update
+    template <std::size_t N>
+    IK2dStepStatus step(const RobotArm2dN<N>& arm, const math::Vector2& target,
+                        IK2dStepState<N>& s) const noexcept
+    {
+        std::array<math::Vector2, N>& J = s.J;
+
+        //dp/dq columns and the end effector
+        const Jacobian2d::Tip tip = Jacobian2d::kernel(arm.link_lengths.data(), s.q.data(), N,
+                                                       JointAngles::CumulativeDq,
+                                                       &J[0].x, &J[0].y, 2);
+
+        const double ex = target.x - tip.p.x;
+        const double ey = target.y - tip.p.y;
+        s.residual = std::sqrt(ex * ex + ey * ey);
+        if (s.residual < tol)
+            return IK2dStepStatus::Converged;
+
+        double a = lambda * lambda, b = 0.0, c = lambda * lambda;
+        for (std::size_t i = 0; i < N; ++i) {
+            a += J[i].x * J[i].x;
+            b += J[i].x * J[i].y;
+            c += J[i].y * J[i].y;
+        }
+
+        const double det = a * c - b * b;
+        if (std::abs(det) < 1e-12)
+            return IK2dStepStatus::Singular;
+
+        const double v0 = alpha * ( c * ex - b * ey) / det;
+        const double v1 = alpha * (-b * ex + a * ey) / det;
+
+        for (std::size_t i = 0; i < N; ++i)
+            s.q[i] += J[i].x * v0 + J[i].y * v1;
+
+        ++s.steps;
+        return IK2dStepStatus::Stepped;
+    }
+
+    //One servo tick: updates within the budget, stopping early on
+    //convergence or a singular system
+    template <std::size_t N>
+    IK2dStepStatus run(const RobotArm2dN<N>& arm, const math::Vector2& target,
+                       IK2dStepState<N>& s, const IK2dStepBudget& budget) const noexcept
+    {
+        using clock = std::chrono::steady_clock;
+
+        const bool timed = budget.time.count() > 0;
+        const clock::time_point start = timed ? clock::now() : clock::time_point{};
+        clock::time_point last = start;
+        clock::duration slowest{0};
+
+        IK2dStepStatus status = IK2dStepStatus::Stepped;
+        for (int k = 0; k < budget.max_steps || k == 0; ++k) {
+            status = step(arm, target, s);
+            if (status != IK2dStepStatus::Stepped)
+                return status;
+
+            if (timed) {
+                const clock::time_point now = clock::now();
+                slowest = std::max(slowest, now - last);
+                last = now;
+                if (now - start + slowest > budget.time)
+                    break;
+            }
+        }
+        return status;
+    }
+};
+
+} // namespace robot
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace robot {
+
+//Why an IK2d solve stopped
+enum class IK2dStatus {
+    Converged,     //end-effector error below tol
+    MaxIterations, //used all max_iters updates
+    Singular,      //damped J * J^T had |det| < 1e-12 (IK3d: damping diverged)
+    Cancelled,     //IK2dWorkspace::cancel was raised
+    Unreachable    //closed form: target outside the workspace, q is the closest reach
+};
+
+//Outcome of a workspace IK2d solve; the joint angles are left in IK2dWorkspace::q
+struct IK2dResult {
+    IK2dStatus status = IK2dStatus::MaxIterations;
+    int iterations = 0;    //joint updates applied
+    double residual = 0.0; //end-effector error at the returned q
+    double seconds = 0.0;  //wall time of the solve; measured only when
+                           //IK2dWorkspace::telemetry is set, 0 otherwise
+
+    bool converged() const { return status == IK2dStatus::Converged; }
+};
+
+//Counter sink aggregating IK2d results across calls and threads: outcome
+//counts plus power-of-two histograms of iterations and latency. IK2d records
+//every solve into the sink attached to IK2dWorkspace::telemetry; with no
+//sink attached a solve neither reads the clock nor records anything.
+struct IK2dTelemetry {
+    static constexpr size_t kStatuses = 5;
+    static constexpr size_t kBuckets = 32;
+
+    std::array<std::atomic<uint64_t>, kStatuses> status_counts{};
+    //bucket 0 holds 0, bucket b > 0 holds [2^(b-1), 2^b)
+    std::array<std::atomic<uint64_t>, kBuckets> iteration_hist{};
+    std::array<std::atomic<uint64_t>, kBuckets> latency_ns_hist{};
+    std::atomic<uint64_t> total_iterations{0};
+    std::atomic<uint64_t> total_ns{0};
+
+    void record(const IK2dResult& r) noexcept {
+        uint64_t ns = static_cast<uint64_t>(r.seconds * 1e9);
+        uint64_t iters = static_cast<uint64_t>(r.iterations);
+
+        status_counts[static_cast<size_t>(r.status)].fetch_add(1, std::memory_order_relaxed);
+        iteration_hist[bucket(iters)].fetch_add(1, std::memory_order_relaxed);
+        latency_ns_hist[bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+        total_iterations.fetch_add(iters, std::memory_order_relaxed);
+        total_ns.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    uint64_t solves() const {
+        uint64_t n = 0;
+        for (const auto& c : status_counts)
+            n += c.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    uint64_t count(IK2dStatus s) const {
+        return status_counts[static_cast<size_t>(s)].load(std::memory_order_relaxed);
+    }
+
+    //Upper bound of the histogram bucket containing quantile p in [0, 1]
+    static uint64_t quantile(const std::array<std::atomic<uint64_t>, kBuckets>& hist, double p) {
+        uint64_t total = 0;
+        for (const auto& c : hist)
+            total += c.load(std::memory_order_relaxed);
+        if (total == 0)
+            return 0;
+
+        uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            seen += hist[b].load(std::memory_order_relaxed);
+            if (seen >= rank)
+                return b == 0 ? 0 : (uint64_t{1} << b) - 1;
+        }
+        return ~uint64_t{0};
+    }
+
+    void reset() noexcept {
+        for (auto& c : status_counts) c.store(0, std::memory_order_relaxed);
+        for (auto& c : iteration_hist) c.store(0, std::memory_order_relaxed);
+        for (auto& c : latency_ns_hist) c.store(0, std::memory_order_relaxed);
+        total_iterations.store(0, std::memory_order_relaxed);
+        total_ns.store(0, std::memory_order_relaxed);
+    }
+
+    static size_t bucket(uint64_t v) {
+        size_t b = 0;
+        while (v != 0 && b + 1 < kBuckets) {
+            v >>= 1;
+            ++b;
+        }
+        return b;
+    }
+};
+
+} // namespace robot
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "robot/robot_arm_3d.hpp"
+#include "robot/ik_2d_telemetry.hpp"
+#include "math/se3.hpp"
+
+namespace robot {
+
+//The spatial solver reports with the same status/result types as IK2d
+using IK3dStatus = IK2dStatus;
+using IK3dResult = IK2dResult;
+
+//Reusable buffers for IK3d::solve. Two sets of frames/Jacobian columns are kept
+//so a rejected trial step never has to recompute the accepted linearisation.
+struct IK3dWorkspace {
+    std::vector<double> q;                  //current / final joint angles
+    std::vector<double> q_trial;
+    std::vector<math::SE3> frames, frames_trial;
+    std::vector<JacobianColumn3d> J, J_trial;
+
+    IK3dWorkspace() = default;
+
+    explicit IK3dWorkspace(const RobotArm3d& arm) {
+        resize(arm.dof());
+    }
+
+    void resize(size_t N) {
+        q.resize(N);
+        q_trial.resize(N);
+        frames.resize(N);
+        frames_trial.resize(N);
+        J.resize(N);
+        J_trial.resize(N);
+    }
+};
+
+//Levenberg-Marquardt IK for full pose targets. With W = diag(1, 1, 1, w, w, w)
+//weighting the rotation rows, each step solves the damped 6x6 normal
+//equations ((W J)(W J)^T + mu I) y = W e with a stack Cholesky and moves by
+//dq = (W J)^T y; mu shrinks after a step that lowers the error and grows after
+//one that does not (the step is then undone).
+struct IK3d {
+    static std::vector<double>
+    solve(const RobotArm3d& arm,
+          const math::SE3& target,
+          const std::vector<double>& q0,
+          double tol = 1e-6,
+          int max_iters = 100,
+          double lambda = 1e-3,
+          double orientation_weight = 1.0)
+    {
+        IK3dWorkspace ws(arm);
+        solve(arm, target, q0, ws, tol, max_iters, lambda, orientation_weight);
+        return ws.q;
+    }
+
+    //Workspace variant: the solution is left in ws.q. residual is the norm of
+    //the 6-vector (position error, orientation_weight * rotation vector error).
+    //q0 may be ws.q itself to warm-start from the previous solution.
+    static IK3dResult
+    solve(const RobotArm3d& arm,
+          const math::SE3& target,
+          const std::vector<double>& q0,
+          IK3dWorkspace& ws,
+          double tol = 1e-6,
+          int max_iters = 100,
+          double lambda = 1e-3,
+          double orientation_weight = 1.0)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+
+        const size_t N = q0.size();
+        if (ws.q.size() != N)
+            ws.resize(N);
+
+        std::vector<double>& q = ws.q;
+        if (&q0 != &q)
+            q.assign(q0.begin(), q0.end());
+
+        const double w = orientation_weight;
+        double mu = lambda * lambda;
+
+        double e[6];
+        auto T = arm.kinematics(q, ws.frames, ws.J);
+        double err = pose_error(target, T, w, e);
+
+        IK3dResult result;
+
+        for (int iter = 0; ; ++iter) {
+            result.residual = err;
+            if (err < tol) {
+                result.status = IK3dStatus::Converged;
+                return finish(result, t0);
+            }
+            if (iter >= max_iters) {
+                result.status = IK3dStatus::MaxIterations;
+                return finish(result, t0);
+            }
+            if (mu > kMaxDamping) {
+                result.status = IK3dStatus::Singular;
+                return finish(result, t0);
+            }
+
+            //A = (W J)(W J)^T + mu I, W = diag(1, 1, 1, w, w, w) applied to the rows
+            const std::vector<JacobianColumn3d>& J = ws.J;
+            double A[6][6] = {};
+            for (size_t i = 0; i < N; ++i) {
+                const double c[6] = {
+                    J[i].linear.x, J[i].linear.y, J[i].linear.z,
+                    w * J[i].angular.x, w * J[i].angular.y, w * J[i].angular.z
+                };
+                for (int r = 0; r < 6; ++r)
+                    for (int k = 0; k <= r; ++k)
+                        A[r][k] += c[r] * c[k];
+            }
+            for (int r = 0; r < 6; ++r)
+                A[r][r] += mu;
+
+            double y[6] = {e[0], e[1], e[2], e[3], e[4], e[5]};
+            if (!cholesky_solve(A, y)) {
+                mu *= kDampingUp;
+                result.iterations = iter + 1;
+                continue;
+            }
+
+            //dq = (W J)^T y
+            for (size_t i = 0; i < N; ++i) {
+                ws.q_trial[i] = q[i]
+                    + J[i].linear.x * y[0] + J[i].linear.y * y[1] + J[i].linear.z * y[2]
+                    + w * (J[i].angular.x * y[3] + J[i].angular.y * y[4] + J[i].angular.z * y[5]);
+            }
+
+            double e_trial[6];
+            auto T_trial = arm.kinematics(ws.q_trial, ws.frames_trial, ws.J_trial);
+            double err_trial = pose_error(target, T_trial, w, e_trial);
+
+            if (err_trial < err) {
+                std::swap(ws.q, ws.q_trial);
+                std::swap(ws.frames, ws.frames_trial);
+                std::swap(ws.J, ws.J_trial);
+                for (int r = 0; r < 6; ++r) e[r] = e_trial[r];
+                err = err_trial;
+                mu = std::max(mu * kDampingDown, kMinDamping);
+            } else {
+                mu *= kDampingUp;
+            }
+
+            result.iterations = iter + 1;
+        }
+    }
+
+    //Rotation vector (axis * angle) of R, the matrix log map of SO(3)
+    static math::Vector3 rotation_log(const math::Matrix3& R) {
+        using math::Vector3;
+
+        //sin(angle) * axis and cos(angle)
+        Vector3 s{0.5 * (R.m21 - R.m12), 0.5 * (R.m02 - R.m20), 0.5 * (R.m10 - R.m01)};
+        double c = 0.5 * (R.m00 + R.m11 + R.m22 - 1.0);
+        double sn = s.norm();
+
+        if (sn > 1e-9)
+            return s * (std::atan2(sn, c) / sn);
+        if (c > 0.0)
+            return s; //near identity
+
+        //near a half turn: axis from the diagonal, signs from the off-diagonals
+        Vector3 axis{
+            std::sqrt(std::max(0.0, 0.5 * (R.m00 + 1.0))),
+            std::sqrt(std::max(0.0, 0.5 * (R.m11 + 1.0))),
+            std::sqrt(std::max(0.0, 0.5 * (R.m22 + 1.0)))
+        };
+        if (axis.x >= axis.y && axis.x >= axis.z) {
+            if (R.m01 + R.m10 < 0.0) axis.y = -axis.y;
+            if (R.m02 + R.m20 < 0.0) axis.z = -axis.z;
+        } else if (axis.y >= axis.z) {
+            if (R.m01 + R.m10 < 0.0) axis.x = -axis.x;
+            if (R.m12 + R.m21 < 0.0) axis.z = -axis.z;
+        } else {
+            if (R.m02 + R.m20 < 0.0) axis.x = -axis.x;
+            if (R.m12 + R.m21 < 0.0) axis.y = -axis.y;
+        }
+        return axis.normalized() * M_PI;
+    }
+
+private:
+    static constexpr double kMinDamping = 1e-12;
+    static constexpr double kMaxDamping = 1e12;
+    static constexpr double kDampingDown = 0.3;
+    static constexpr double kDampingUp = 4.0;
+
+    //weighted 6D error of T against target in the world frame; returns its norm
+    static double pose_error(const math::SE3& target, const math::SE3& T, double w, double e[6]) {
+        math::Vector3 dp = target.t - T.t;
+        math::Vector3 dr = rotation_log(target.R * T.R.transpose());
+
+        e[0] = dp.x;     e[1] = dp.y;     e[2] = dp.z;
+        e[3] = w * dr.x; e[4] = w * dr.y; e[5] = w * dr.z;
+
+        double sq = 0.0;
+        for (int r = 0; r < 6; ++r) sq += e[r] * e[r];
+        return std::sqrt(sq);
+    }
+
+    //Solves A y = b in place for symmetric positive definite A, of which only
+    //the lower triangle is read. Returns false if A is not positive definite.
+    static bool cholesky_solve(double A[6][6], double b[6]) {
+        for (int j = 0; j < 6; ++j) {
+            double d = A[j][j];
+            for (int k = 0; k < j; ++k) d -= A[j][k] * A[j][k];
+            if (d <= 0.0)
+                return false;
+            d = std::sqrt(d);
+            A[j][j] = d;
+
+            for (int i = j + 1; i < 6; ++i) {
+                double v = A[i][j];
+                for (int k = 0; k < j; ++k) v -= A[i][k] * A[j][k];
+                A[i][j] = v / d;
+            }
+        }
+
+        //L z = b, then L^T y = z
+        for (int i = 0; i < 6; ++i) {
+            double v = b[i];
+            for (int k = 0; k < i; ++k) v -= A[i][k] * b[k];
+            b[i] = v / A[i][i];
+        }
+        for (int i = 5; i >= 0; --i) {
+            double v = b[i];
+            for (int k = i + 1; k < 6; ++k) v -= A[k][i] * b[k];
+            b[i] = v / A[i][i];
+        }
+        return true;
+    }
+
+    static IK3dResult finish(IK3dResult& result, std::chrono::steady_clock::time_point t0) {
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        return result;
+    }
+};
+
+} // namespace robot
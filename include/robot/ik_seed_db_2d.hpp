@@ -0,0 +1,309 @@
+#pragma once
+
+#include "math/vector2.hpp"
+#include "robot/ik_2d.hpp"
+#include "robot/jacobian_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/mapped_file.hpp"
+#include "util/thread_pool.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace robot {
+
+//Scratch and output of IKSeedDatabase2d::nearest: entry indices sorted by
+//distance, and their squared end-effector distances to the target
+struct IKSeedQuery2d {
+    std::vector<size_t> index;
+    std::vector<double> d2;
+};
+
+//Precomputed (end-effector position -> joint configuration) pairs of a
+//RobotArm2d, indexed by a 2D k-d tree for warm-starting IK: the stored
+//configurations whose end effectors lie nearest a new target are already
+//close to a solution, so IK2d::solve from them needs a few iterations where
+//an arbitrary q0 needs dozens.
+//
+//The tree is implicit in the entry order: range [lo, hi) splits at its
+//middle entry on x at even depths and y at odd ones, down to leaves of at
+//most kLeaf entries. Nothing but the entries is stored, so the file written
+//by save() is the index, and load() memory-maps it and queries in place.
+class IKSeedDatabase2d {
+public:
+    static constexpr size_t kLeaf = 8;
+
+    IKSeedDatabase2d() = default;
+
+    //Samples `entries` configurations with every joint uniform in [-pi, pi).
+    //Sampling is split into fixed, separately seeded chunks across the pool,
+    //so the database is identical for any pool size; the tree is then built
+    //serially in O(n log n).
+    static IKSeedDatabase2d build(const RobotArm2d& arm,
+                                  size_t entries,
+                                  util::ThreadPool& pool,
+                                  uint64_t seed = 1)
+    {
+        const size_t N = arm.link_lengths.size();
+        assert(N > 0);
+
+        std::vector<double> points(2 * entries), configs(N * entries);
+        const size_t chunks = (entries + kChunk - 1) / kChunk;
+        std::vector<std::vector<double>> scratch(pool.size(), std::vector<double>(2 * N));
+
+        pool.run(chunks, [&](size_t chunk, size_t slot) {
+            double* jx = scratch[slot].data();
+            double* jy = jx + N;
+            std::mt19937_64 rng(seed ^ (0x9E3779B97F4A7C15ull * (chunk + 1)));
+            std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+            const size_t end = std::min(entries, (chunk + 1) * kChunk);
+            for (size_t e = chunk * kChunk; e < end; ++e) {
+                double* q = configs.data() + e * N;
+                for (size_t i = 0; i < N; ++i) q[i] = angle(rng);
+                //same chain as forward_kinematics
+                const Jacobian2d::Tip tip = Jacobian2d::kernel(arm.link_lengths.data(), q, N,
+                                                               JointAngles::Cumulative, jx, jy, 1);
+                points[2 * e] = tip.p.x;
+                points[2 * e + 1] = tip.p.y;
+            }
+        });
+
+        std::vector<size_t> order(entries);
+        std::iota(order.begin(), order.end(), size_t{0});
+        build_tree(points, order, 0, entries, 0);
+
+        IKSeedDatabase2d db;
+        db.links_ = arm.link_lengths;
+        db.size_ = entries;
+        db.own_points_.resize(2 * entries);
+        db.own_configs_.resize(N * entries);
+        for (size_t i = 0; i < entries; ++i) {
+            const size_t e = order[i];
+            db.own_points_[2 * i] = points[2 * e];
+            db.own_points_[2 * i + 1] = points[2 * e + 1];
+            std::copy(configs.begin() + e * N, configs.begin() + (e + 1) * N,
+                      db.own_configs_.begin() + i * N);
+        }
+        db.points_ = db.own_points_.data();
+        db.configs_ = db.own_configs_.data();
+        return db;
+    }
+
+    //single-threaded build
+    static IKSeedDatabase2d build(const RobotArm2d& arm, size_t entries, uint64_t seed = 1) {
+        util::ThreadPool pool(1);
+        return build(arm, entries, pool, seed);
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    size_t dof() const { return links_.size(); }
+    const std::vector<double>& link_lengths() const { return links_; }
+    //true if this database was built for an arm with exactly these links
+    bool matches(const RobotArm2d& arm) const { return links_ == arm.link_lengths; }
+
+    //end effector of entry i and its configuration, dof() doubles
+    math::Vector2 point(size_t i) const { return math::Vector2{points_[2 * i], points_[2 * i + 1]}; }
+    const double* config(size_t i) const { return configs_ + i * links_.size(); }
+
+    //The (up to) k entries nearest target, closest first, into out.
+    //Returns how many were found.
+    size_t nearest(const math::Vector2& target, size_t k, IKSeedQuery2d& out) const {
+        out.index.clear();
+        out.d2.clear();
+        k = std::min(k, size_);
+        if (k == 0)
+            return 0;
+        out.index.reserve(k);
+        out.d2.reserve(k);
+        search(target, k, 0, size_, 0, out);
+        return out.index.size();
+    }
+
+    //IK2d::solve from the nearest k entries in turn until one converges.
+    //Returns that solve's result, or the last one's if none converges; the
+    //solution is left in ws.q. With no entry to start from (an empty
+    //database or k == 0) it solves from ws.q as it stands.
+    IK2dResult solve(const RobotArm2d& arm,
+                     const math::Vector2& target,
+                     IK2dWorkspace& ws,
+                     IKSeedQuery2d& query,
+                     size_t k = 1,
+                     double tol = 1e-6,
+                     int max_iters = 100,
+                     double alpha = 1.0,
+                     double lambda = 0.1,
+                     IK2dDamping damping = IK2dDamping::Fixed) const
+    {
+        assert(empty() || matches(arm));
+        const size_t N = arm.link_lengths.size();
+        const size_t found = nearest(target, k, query);
+        if (found == 0) {
+            if (ws.q.size() != N)
+                ws.resize(N);
+            return IK2d::solve(arm, target, ws.q, ws, tol, max_iters, alpha, lambda, damping);
+        }
+
+        IK2dResult r;
+        for (size_t j = 0; j < found; ++j) {
+            ws.q.assign(config(query.index[j]), config(query.index[j]) + N);
+            r = IK2d::solve(arm, target, ws.q, ws, tol, max_iters, alpha, lambda, damping);
+            if (r.converged())
+                break;
+        }
+        return r;
+    }
+
+    //Binary file: magic, version, entry count, link count, the link
+    //lengths, then the end-effector points and configurations in tree order,
+    //native byte order. Returns false on I/O failure.
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out || empty())
+            return false;
+
+        Header h;
+        std::memcpy(h.magic, kMagic, sizeof(kMagic));
+        h.version = kVersion;
+        h.entries = size_;
+        h.links = links_.size();
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(links_.data()),
+                  static_cast<std::streamsize>(links_.size() * sizeof(double)));
+        out.write(reinterpret_cast<const char*>(points_),
+                  static_cast<std::streamsize>(2 * size_ * sizeof(double)));
+        out.write(reinterpret_cast<const char*>(configs_),
+                  static_cast<std::streamsize>(links_.size() * size_ * sizeof(double)));
+        return static_cast<bool>(out);
+    }
+
+    //Memory-maps a file written by save(). Returns false, leaving db
+    //untouched, if the file is missing, truncated or of another format or
+    //version.
+    static bool load(const std::string& path, IKSeedDatabase2d& db) {
+        util::MappedFile file;
+        if (!file.open(path) || file.size() < sizeof(Header))
+            return false;
+
+        Header h;
+        std::memcpy(&h, file.data(), sizeof(h));
+        if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion)
+            return false;
+        if (h.entries == 0 || h.entries > kMaxEntries || h.links == 0 || h.links > kMaxLinks)
+            return false;
+
+        const size_t links_at = sizeof(Header);
+        const size_t points_at = links_at + h.links * sizeof(double);
+        const size_t configs_at = points_at + 2 * h.entries * sizeof(double);
+        if (file.size() != configs_at + h.links * h.entries * sizeof(double))
+            return false;
+
+        IKSeedDatabase2d loaded;
+        loaded.size_ = h.entries;
+        loaded.links_.resize(h.links);
+        std::memcpy(loaded.links_.data(), file.data() + links_at, h.links * sizeof(double));
+        loaded.points_ = reinterpret_cast<const double*>(file.data() + points_at);
+        loaded.configs_ = reinterpret_cast<const double*>(file.data() + configs_at);
+        loaded.file_ = std::move(file);
+        db = std::move(loaded);
+        return true;
+    }
+
+private:
+    static constexpr char kMagic[4] = {'I', 'K', 'S', '2'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint64_t kMaxEntries = uint64_t{1} << 32;
+    static constexpr uint64_t kMaxLinks = 1024;
+    static constexpr size_t kChunk = size_t{1} << 14; //entries per parallel task
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t entries;
+        uint64_t links;
+    };
+    static_assert(sizeof(Header) % sizeof(double) == 0, "arrays after the header must stay aligned");
+
+    //reorders order[lo, hi) into the implicit tree layout
+    static void build_tree(const std::vector<double>& points, std::vector<size_t>& order,
+                           size_t lo, size_t hi, size_t depth)
+    {
+        if (hi - lo <= kLeaf)
+            return;
+        const size_t mid = lo + (hi - lo) / 2;
+        const size_t axis = depth & 1;
+        std::nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi,
+                         [&](size_t a, size_t b) { return points[2 * a + axis] < points[2 * b + axis]; });
+        build_tree(points, order, lo, mid, depth + 1);
+        build_tree(points, order, mid + 1, hi, depth + 1);
+    }
+
+    //keeps out sorted by distance, at most k long
+    void offer(const math::Vector2& target, size_t i, size_t k, IKSeedQuery2d& out) const {
+        const double dx = points_[2 * i] - target.x;
+        const double dy = points_[2 * i + 1] - target.y;
+        const double d2 = dx * dx + dy * dy;
+        if (out.index.size() == k) {
+            if (d2 >= out.d2.back())
+                return;
+            out.index.pop_back();
+            out.d2.pop_back();
+        }
+        size_t j = out.d2.size();
+        out.index.push_back(i);
+        out.d2.push_back(d2);
+        for (; j > 0 && out.d2[j - 1] > d2; --j) {
+            out.index[j] = out.index[j - 1];
+            out.d2[j] = out.d2[j - 1];
+        }
+        out.index[j] = i;
+        out.d2[j] = d2;
+    }
+
+    void search(const math::Vector2& target, size_t k, size_t lo, size_t hi, size_t depth,
+                IKSeedQuery2d& out) const
+    {
+        if (hi - lo <= kLeaf) {
+            for (size_t i = lo; i < hi; ++i)
+                offer(target, i, k, out);
+            return;
+        }
+        const size_t mid = lo + (hi - lo) / 2;
+        const size_t axis = depth & 1;
+        const double diff = (axis == 0 ? target.x : target.y) - points_[2 * mid + axis];
+
+        offer(target, mid, k, out);
+        //near side first, so the far side is usually pruned
+        if (diff < 0.0) {
+            search(target, k, lo, mid, depth + 1, out);
+            if (out.index.size() < k || diff * diff < out.d2.back())
+                search(target, k, mid + 1, hi, depth + 1, out);
+        } else {
+            search(target, k, mid + 1, hi, depth + 1, out);
+            if (out.index.size() < k || diff * diff < out.d2.back())
+                search(target, k, lo, mid, depth + 1, out);
+        }
+    }
+
+    size_t size_ = 0;
+    std::vector<double> links_;
+
+    //points_/configs_ point into own_* after build() or into file_ after load()
+    const double* points_ = nullptr;
+    const double* configs_ = nullptr;
+    std::vector<double> own_points_;
+    std::vector<double> own_configs_;
+    util::MappedFile file_;
+};
+
+} // namespace robot
@@ -1,49 +1,115 @@
 #pragma once
 
 #include <vector>
+#include <cassert>
 #include <cmath>
+#include <cstddef>
+
+#include "math/vector2.hpp"
 
 namespace robot {
 
+//How joint angles map to world link angles
+enum class JointAngles {
+    //textbook serial arm: link k is at q1 + ... + qk
+    Relative,
+    //RobotArm2d: joint k rotates by c_k = q1 + ... + qk relative to the
+    //previous link, so link k is at c_1 + ... + c_k. Jacobian columns are
+    //then taken with respect to c, which is what RobotArm2d::jacobian returns.
+    Cumulative,
+    //RobotArm2d angles as above, columns taken with respect to q itself: the
+    //true Jacobian of the arm's joint angles, which IK has to step along.
+    //q_k enters every c_j with j >= k, so dp/dq_k is the suffix sum of the
+    //dp/dc columns; the kernel adds that as a second O(N) pass.
+    CumulativeDq
+};
+
 struct Jacobian2d {
-    // computes the 2xN Jacobian for an N-link planar arm
-    // link_lengths: [L1, L2, ..., LN]
-    // q: joint angles [q1, q2, ..., qN]
-    static std::vector<std::vector<double>>
-    compute(const std::vector<double>& link_lengths,
-            const std::vector<double>& q)
+    //end-effector position and the cos/sin of the last link's world angle
+    struct Tip {
+        math::Vector2 p;
+        double c = 1.0, s = 0.0;
+    };
+
+    //Shared O(N) kernel behind Jacobian2d::compute and RobotArm2d::kinematics.
+    //Column i is the sum over links k >= i of L_k * (-sin theta_k, cos theta_k):
+    //a forward pass computes every link's contribution with one sin/cos per
+    //link, then a reverse pass turns them into suffix sums in place. The
+    //column sum of link 0 onwards is the end-effector position rotated by 90
+    //degrees, so the position comes for free.
+    //dx/dq_i is written to jx[i * stride] and dy/dq_i to jy[i * stride]:
+    //jx = J, jy = J + N, stride 1 for a 2xN row-major buffer, or
+    //jx = &cols[0].x, jy = &cols[0].y, stride 2 for an array of Vector2 columns.
+    //The position is taken before the CumulativeDq pass, so it is the same
+    //for every mode.
+    static Tip kernel(const double* link_lengths, const double* q, std::size_t N,
+                      JointAngles angles, double* jx, double* jy, std::size_t stride) noexcept
     {
-        size_t N = link_lengths.size();
+        Tip tip;
+        if (N == 0)
+            return tip;
 
-        //Jacobian: 2 rows, N columns
-        std::vector<std::vector<double>> J(2, std::vector<double>(N, 0.0));
+        double joint = 0.0; //rotation of the current joint
+        double theta = 0.0; //world angle of the current link
+        for (std::size_t i = 0; i < N; ++i) {
+            if (angles != JointAngles::Relative) {
+                joint += q[i];
+                theta += joint;
+            } else {
+                theta += q[i];
+            }
+            tip.c = std::cos(theta);
+            tip.s = std::sin(theta);
 
-        //Precompute cumulative angles: theta1, theta1 + theta2, ...
-        std::vector<double> cumulative(N);
-        double sum = 0.0;
-        for (size_t i = 0; i < N; ++i) {
-            sum += q[i];
-            cumulative[i] = sum;
+            jx[i * stride] = -link_lengths[i] * tip.s;
+            jy[i * stride] = link_lengths[i] * tip.c;
         }
 
-        //Compute each column of the Jacobian
-        for (size_t i = 0; i < N; ++i) {
-            double dx = 0.0;
-            double dy = 0.0;
+        for (std::size_t i = N - 1; i-- > 0; ) {
+            jx[i * stride] += jx[(i + 1) * stride];
+            jy[i * stride] += jy[(i + 1) * stride];
+        }
 
-            //sum contributions from link i to link N
-            for (size_t k = i; k < N; ++k) {
-                double L = link_lengths[k];
-                double angle = cumulative[k];
+        tip.p = math::Vector2{jy[0], -jx[0]};
 
-                dx += -L * std::sin(angle);
-                dy += L * std::cos(angle);
+        if (angles == JointAngles::CumulativeDq) {
+            for (std::size_t i = N - 1; i-- > 0; ) {
+                jx[i * stride] += jx[(i + 1) * stride];
+                jy[i * stride] += jy[(i + 1) * stride];
             }
-
-            J[0][i] = dx;
-            J[1][i] = dy;
         }
+        return tip;
+    }
+
+    // computes the 2xN Jacobian for an N-link planar arm
+    // link_lengths: [L1, L2, ..., LN]
+    // q: joint angles [q1, q2, ..., qN], relative convention
+    static std::vector<std::vector<double>>
+    compute(const std::vector<double>& link_lengths,
+            const std::vector<double>& q)
+    {
+        const std::size_t N = link_lengths.size();
+        assert(q.size() == N);
+
+        //Jacobian: 2 rows, N columns
+        std::vector<std::vector<double>> J(2, std::vector<double>(N, 0.0));
+        if (N > 0)
+            kernel(link_lengths.data(), q.data(), N, JointAngles::Relative,
+                   J[0].data(), J[1].data(), 1);
         return J;
     }
+
+    //as above into a caller-provided 2xN row-major buffer: J[i] = dx/dq_i,
+    //J[N + i] = dy/dq_i. Returns the end-effector position.
+    static math::Vector2
+    compute(const std::vector<double>& link_lengths,
+            const std::vector<double>& q,
+            double* J,
+            JointAngles angles = JointAngles::Relative)
+    {
+        const std::size_t N = link_lengths.size();
+        assert(q.size() == N);
+        return kernel(link_lengths.data(), q.data(), N, angles, J, J + N, 1).p;
+    }
 };
-} //namespace robot
\ No newline at end of file
+} //namespace robot
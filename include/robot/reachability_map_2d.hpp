@@ -0,0 +1,290 @@
+#pragma once
+
+#include "math/vector2.hpp"
+#include "robot/jacobian_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/mapped_file.hpp"
+#include "util/thread_pool.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace robot {
+
+//Workspace map of a RobotArm2d, precomputed offline by sampling joint space:
+//per grid cell, how many sampled configurations put the end effector there
+//and the best manipulability sqrt(det(J J^T)) among them (J = dp/dq). Cell
+//(x, y) covers origin() + [x, x + 1) x [y, y + 1) times resolution(), stored
+//row-major; the grid covers the disc of radius sum(|L|) around the base.
+//Queries are O(1) array lookups, so targets can be rejected or ranked before
+//any IK is run.
+//
+//Sampling makes the map one-sided: a reachable() cell was reached by at
+//least one configuration, but cells on the edges of the workspace (thin
+//regions near full extension or the inner hole) can be missed when too few
+//samples land there. Use enough samples for a few hits per cell, or treat
+//unreached cells next to reached ones as uncertain.
+//
+//Maps are written once by save() and loaded by memory-mapping the file, so
+//startup is independent of the map size and lookups read the page cache.
+class ReachabilityMap2d {
+public:
+    ReachabilityMap2d() = default;
+
+    //Samples `samples` configurations with every joint uniform in [-pi, pi).
+    //Work is split into fixed chunks seeded from seed and the chunk index,
+    //and per-slot grids are merged with sum/max, so the map is identical for
+    //any pool size.
+    static ReachabilityMap2d build(const RobotArm2d& arm,
+                                   double resolution,
+                                   uint64_t samples,
+                                   util::ThreadPool& pool,
+                                   uint64_t seed = 1)
+    {
+        assert(resolution > 0.0);
+        assert(samples <= UINT32_MAX);
+        const size_t N = arm.link_lengths.size();
+
+        double reach = 0.0;
+        for (double L : arm.link_lengths) reach += std::abs(L);
+
+        ReachabilityMap2d map;
+        map.links_ = arm.link_lengths;
+        map.samples_ = samples;
+        map.resolution_ = resolution;
+        //one spare cell on every side keeps full extension off the border
+        const size_t side = static_cast<size_t>(std::ceil(2.0 * reach / resolution)) + 2;
+        map.nx_ = map.ny_ = side;
+        map.origin_ = math::Vector2{-0.5 * static_cast<double>(side) * resolution,
+                                    -0.5 * static_cast<double>(side) * resolution};
+
+        const size_t cells = side * side;
+        const size_t slots = pool.size();
+        std::vector<std::vector<uint32_t>> hits(slots);
+        std::vector<std::vector<float>> best(slots);
+        std::vector<std::vector<double>> scratch(slots);
+
+        const size_t chunks = static_cast<size_t>((samples + kChunk - 1) / kChunk);
+        pool.run(chunks, [&](size_t chunk, size_t slot) {
+            if (hits[slot].empty()) {
+                hits[slot].assign(cells, 0);
+                best[slot].assign(cells, 0.0f);
+                scratch[slot].resize(3 * N);
+            }
+            uint32_t* h = hits[slot].data();
+            float* w = best[slot].data();
+            double* q = scratch[slot].data();
+            double* jx = q + N;
+            double* jy = q + 2 * N;
+
+            std::mt19937_64 rng(seed ^ (0x9E3779B97F4A7C15ull * (chunk + 1)));
+            std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+            const uint64_t begin = chunk * kChunk;
+            const uint64_t end = std::min<uint64_t>(samples, begin + kChunk);
+            for (uint64_t k = begin; k < end; ++k) {
+                for (size_t i = 0; i < N; ++i) q[i] = angle(rng);
+
+                //same chain as forward_kinematics, with the dp/dq Jacobian alongside
+                const Jacobian2d::Tip tip = Jacobian2d::kernel(arm.link_lengths.data(), q, N,
+                                                               JointAngles::CumulativeDq, jx, jy, 1);
+                const long cell = map.cell_index(tip.p);
+                if (cell < 0)
+                    continue;
+
+                double a = 0.0, b = 0.0, c = 0.0;
+                for (size_t i = 0; i < N; ++i) {
+                    a += jx[i] * jx[i];
+                    b += jx[i] * jy[i];
+                    c += jy[i] * jy[i];
+                }
+                const float m = static_cast<float>(std::sqrt(std::max(0.0, a * c - b * b)));
+
+                ++h[cell];
+                w[cell] = std::max(w[cell], m);
+            }
+        });
+
+        map.own_hits_.assign(cells, 0);
+        map.own_best_.assign(cells, 0.0f);
+        pool.run(side, [&](size_t y, size_t) {
+            for (size_t s = 0; s < slots; ++s) {
+                if (hits[s].empty())
+                    continue;
+                for (size_t i = y * side; i < (y + 1) * side; ++i) {
+                    map.own_hits_[i] += hits[s][i];
+                    map.own_best_[i] = std::max(map.own_best_[i], best[s][i]);
+                }
+            }
+        });
+        for (float m : map.own_best_)
+            map.max_manipulability_ = std::max(map.max_manipulability_, static_cast<double>(m));
+
+        map.hits_ = map.own_hits_.data();
+        map.best_ = map.own_best_.data();
+        return map;
+    }
+
+    //single-threaded build
+    static ReachabilityMap2d build(const RobotArm2d& arm, double resolution,
+                                   uint64_t samples, uint64_t seed = 1)
+    {
+        util::ThreadPool pool(1);
+        return build(arm, resolution, samples, pool, seed);
+    }
+
+    bool empty() const { return hits_ == nullptr; }
+    size_t width() const { return nx_; }
+    size_t height() const { return ny_; }
+    double resolution() const { return resolution_; }
+    math::Vector2 origin() const { return origin_; }
+    uint64_t samples() const { return samples_; }
+    const std::vector<double>& link_lengths() const { return links_; }
+    //largest manipulability in the map, to normalise manipulability()
+    double max_manipulability() const { return max_manipulability_; }
+    //true if this file was built for an arm with exactly these links
+    bool matches(const RobotArm2d& arm) const { return links_ == arm.link_lengths; }
+
+    //sampled configurations ending in the cell containing p; 0 off the grid
+    uint32_t hits(const math::Vector2& p) const {
+        const long cell = cell_index(p);
+        return cell < 0 ? 0 : hits_[cell];
+    }
+
+    bool reachable(const math::Vector2& p) const { return hits(p) > 0; }
+
+    //best sqrt(det(J J^T)) seen in the cell containing p; 0 if unreached
+    double manipulability(const math::Vector2& p) const {
+        const long cell = cell_index(p);
+        return cell < 0 ? 0.0 : static_cast<double>(best_[cell]);
+    }
+
+    //per-cell arrays, row-major
+    const uint32_t* hits_data() const { return hits_; }
+    const float* manipulability_data() const { return best_; }
+
+    //Binary file: magic, version, grid size, sample count, link count,
+    //origin, resolution, max manipulability, the link lengths, then the hit
+    //counts and manipulabilities row-major in native byte order. Every array
+    //starts at an offset aligned to its element type so load() can use the
+    //mapping in place. Returns false on I/O failure.
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out || empty())
+            return false;
+
+        Header h;
+        std::memcpy(h.magic, kMagic, sizeof(kMagic));
+        h.version = kVersion;
+        h.nx = nx_;
+        h.ny = ny_;
+        h.samples = samples_;
+        h.links = links_.size();
+        h.origin_x = origin_.x;
+        h.origin_y = origin_.y;
+        h.resolution = resolution_;
+        h.max_manipulability = max_manipulability_;
+
+        const size_t cells = nx_ * ny_;
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(links_.data()),
+                  static_cast<std::streamsize>(links_.size() * sizeof(double)));
+        out.write(reinterpret_cast<const char*>(hits_),
+                  static_cast<std::streamsize>(cells * sizeof(uint32_t)));
+        out.write(reinterpret_cast<const char*>(best_),
+                  static_cast<std::streamsize>(cells * sizeof(float)));
+        return static_cast<bool>(out);
+    }
+
+    //Memory-maps a file written by save(). Returns false, leaving map
+    //untouched, if the file is missing, truncated or of another format or
+    //version.
+    static bool load(const std::string& path, ReachabilityMap2d& map) {
+        util::MappedFile file;
+        if (!file.open(path) || file.size() < sizeof(Header))
+            return false;
+
+        Header h;
+        std::memcpy(&h, file.data(), sizeof(h));
+        if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion)
+            return false;
+        if (h.nx == 0 || h.ny == 0 || h.nx > kMaxSide || h.ny > kMaxSide ||
+            h.links > kMaxLinks || !(h.resolution > 0.0))
+            return false;
+
+        const size_t cells = h.nx * h.ny;
+        const size_t links_at = sizeof(Header);
+        const size_t hits_at = links_at + h.links * sizeof(double);
+        const size_t best_at = hits_at + cells * sizeof(uint32_t);
+        if (file.size() != best_at + cells * sizeof(float))
+            return false;
+
+        std::vector<double> links(h.links);
+        std::memcpy(links.data(), file.data() + links_at, h.links * sizeof(double));
+
+        ReachabilityMap2d loaded;
+        loaded.nx_ = h.nx;
+        loaded.ny_ = h.ny;
+        loaded.samples_ = h.samples;
+        loaded.origin_ = math::Vector2{h.origin_x, h.origin_y};
+        loaded.resolution_ = h.resolution;
+        loaded.max_manipulability_ = h.max_manipulability;
+        loaded.links_ = std::move(links);
+        loaded.hits_ = reinterpret_cast<const uint32_t*>(file.data() + hits_at);
+        loaded.best_ = reinterpret_cast<const float*>(file.data() + best_at);
+        loaded.file_ = std::move(file);
+        map = std::move(loaded);
+        return true;
+    }
+
+private:
+    static constexpr char kMagic[4] = {'R', 'M', 'P', '2'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint64_t kMaxSide = uint64_t{1} << 16;
+    static constexpr uint64_t kMaxLinks = 1024;
+    static constexpr uint64_t kChunk = uint64_t{1} << 16; //samples per parallel task
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t nx, ny;
+        uint64_t samples;
+        uint64_t links;
+        double origin_x, origin_y;
+        double resolution;
+        double max_manipulability;
+    };
+    static_assert(sizeof(Header) % sizeof(double) == 0, "arrays after the header must stay aligned");
+
+    //row-major index of the cell containing p, or -1 off the grid
+    long cell_index(const math::Vector2& p) const {
+        const double fx = (p.x - origin_.x) / resolution_;
+        const double fy = (p.y - origin_.y) / resolution_;
+        if (!(fx >= 0.0 && fy >= 0.0 && fx < static_cast<double>(nx_) && fy < static_cast<double>(ny_)))
+            return -1;
+        return static_cast<long>(static_cast<size_t>(fy) * nx_ + static_cast<size_t>(fx));
+    }
+
+    size_t nx_ = 0, ny_ = 0;
+    uint64_t samples_ = 0;
+    math::Vector2 origin_{0.0, 0.0};
+    double resolution_ = 1.0;
+    double max_manipulability_ = 0.0;
+    std::vector<double> links_;
+
+    //hits_/best_ point into own_* after build() or into file_ after load()
+    const uint32_t* hits_ = nullptr;
+    const float* best_ = nullptr;
+    std::vector<uint32_t> own_hits_;
+    std::vector<float> own_best_;
+    util::MappedFile file_;
+};
+
+} // namespace robot
@@ -1,107 +1,216 @@
 #pragma once
 
 #include "math/se2.hpp"
+#include "math/se2_compact.hpp"
+#include "math/so2.hpp"
+#include "robot/jacobian_2d.hpp"
 #include <vector>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
 
 namespace robot {
 
+//Vector2 arrays are handed to Jacobian2d::kernel as packed (x, y) doubles
+static_assert(sizeof(math::Vector2) == 2 * sizeof(double), "Vector2 must be two packed doubles");
+
 struct RobotArm2d {
     std::vector<double> link_lengths;
 
     explicit RobotArm2d(std::initializer_list<double> lengths)
         : link_lengths(lengths) {}
 
+    //SO2 chains are pulled back onto the unit circle every 16 joints
+    static constexpr size_t kRenormalizeMask = 15;
+
     math::SE2 forward_kinematics(const std::vector<double>& q) const {
-        using math::SE2;
-        using math::Vector2;
+        using math::SE2Compact;
+        using math::SO2;
 
         assert(q.size() == link_lengths.size());
 
-        SE2 T; //identity transform
-        double theta_total = 0.0;
+        //rotations are chained as unit complex numbers: one sin/cos per joint
+        //and no matrix products
+        SE2Compact T; //identity transform
+        SO2 cumulative;
 
         for(size_t i = 0; i < link_lengths.size(); ++i) {
-            theta_total += q[i];
-            double L = link_lengths[i];
-
             //Rotate by cumulative joint angle
-            SE2 joint = SE2::from_angle_translation(theta_total, Vector2{0.0, 0.0});
+            cumulative = cumulative * SO2::from_angle(q[i]);
+            T.R = T.R * cumulative;
+
             //Translate along the link in the rotated frame
-            SE2 link = SE2::from_angle_translation(0.0, Vector2{L, 0.0});
+            double L = link_lengths[i];
+            T.t.x += L * T.R.c;
+            T.t.y += L * T.R.s;
 
-            //Compose SE2
-            T = T * joint * link;
+            if ((i & kRenormalizeMask) == kRenormalizeMask) {
+                cumulative.renormalize();
+                T.renormalize();
+            }
         }
 
-        return T;
+        return T.to_se2();
     }
     
     //world-frame positions of each joint origin
     std::vector<math::Vector2> joint_positions(const std::vector<double>& q) const {
+        std::vector<math::Vector2> positions;
+        joint_positions(q, positions);
+        return positions;
+    }
+
+    //as above, writing into a caller-owned vector that keeps its capacity across calls
+    void joint_positions(const std::vector<double>& q,
+                         std::vector<math::Vector2>& positions) const {
+        chain_points(q, positions, false);
+    }
+
+    //joint origins followed by the end-effector position (N + 1 points), so
+    //link i is the segment points[i] - points[i + 1]
+    void link_points(const std::vector<double>& q,
+                     std::vector<math::Vector2>& points) const {
+        chain_points(q, points, true);
+    }
+
+    // 2xN Jacobian represented as N column vectors (each Vector2 is a column)
+    std::vector<math::Vector2> jacobian(const std::vector<double>& q) const {
+        std::vector<math::Vector2> J;
+        std::vector<math::Vector2> joints;
+        kinematics(q, joints, J);
+        return J;
+    }
+
+    //as above, writing into caller-owned vectors; joints is scratch for the joint origins
+    void jacobian(const std::vector<double>& q,
+                  std::vector<math::Vector2>& J,
+                  std::vector<math::Vector2>& joints) const {
+        kinematics(q, joints, J);
+    }
+
+    //Fused kernel: end-effector pose, joint origins and Jacobian columns with
+    //one sin/cos per joint, through the O(N) suffix-sum kernel shared with
+    //Jacobian2d (JointAngles::Cumulative). Column j is z-hat x (p_end - p_j),
+    //so each joint origin is recovered from its column as p_end - (J_y, -J_x);
+    //results match forward_kinematics, joint_positions and jacobian.
+    math::SE2 kinematics(const std::vector<double>& q,
+                         std::vector<math::Vector2>& joints,
+                         std::vector<math::Vector2>& J) const {
+        using math::Matrix2;
         using math::SE2;
         using math::Vector2;
 
         assert(q.size() == link_lengths.size());
 
-        std::vector<Vector2> positions;
-        positions.reserve(q.size());
+        const size_t N = link_lengths.size();
+        joints.resize(N);
+        J.resize(N);
+        if (N == 0)
+            return SE2();
 
-        SE2 T; //identity
-        double theta_total = 0.0;
+        const Jacobian2d::Tip tip = Jacobian2d::kernel(link_lengths.data(), q.data(), N,
+                                                       JointAngles::Cumulative,
+                                                       &J[0].x, &J[0].y, 2);
 
-        for (size_t i = 0; i < link_lengths.size(); ++i) {
-            theta_total += q[i];
-            double L = link_lengths[i];
+        for (size_t j = 0; j < N; ++j)
+            joints[j] = Vector2{tip.p.x - J[j].y, tip.p.y + J[j].x};
 
-            SE2 joint = SE2::from_angle_translation(theta_total, Vector2{0.0, 0.0});
-            SE2 link = SE2::from_angle_translation(0.0, Vector2{L, 0.0});
-
-            // move to joint i frame
-            T = T * joint;
-
-            // store joint origin before translating along the link
-            positions.push_back(T * Vector2{0.0, 0.0});
+        return SE2(Matrix2(tip.c, -tip.s,
+                           tip.s, tip.c), tip.p);
+    }
 
-            // advance to end of link i
-            T = T * link;
+    //Batched forward kinematics over `batch` configurations in structure-of-arrays
+    //layout. q is joint-major: q[i * batch + b] is joint i of configuration b.
+    //Writes the end-effector pose of configuration b as (x[b], y[b], theta[b]),
+    //matching forward_kinematics(q_b) == SE2::from_angle_translation(theta, {x, y}).
+    //If joints_x/joints_y are given they receive the joint origins in the same
+    //joint-major layout (N * batch), matching joint_positions(q_b).
+    void forward_kinematics_batch(const double* q, std::size_t batch,
+                                  double* x, double* y, double* theta,
+                                  double* joints_x = nullptr,
+                                  double* joints_y = nullptr) const {
+        //configurations are processed in tiles so the cumulative joint angles
+        //stay in a small stack buffer and every inner loop runs over contiguous
+        //batch lanes with no dependency between them
+        constexpr std::size_t kTile = 256;
+        double cumulative[kTile];
+
+        const std::size_t N = link_lengths.size();
+
+        for (std::size_t b0 = 0; b0 < batch; b0 += kTile) {
+            const std::size_t n = (batch - b0 < kTile) ? batch - b0 : kTile;
+
+            double* px = x + b0;
+            double* py = y + b0;
+            double* th = theta + b0;
+
+            for (std::size_t b = 0; b < n; ++b) {
+                cumulative[b] = 0.0;
+                px[b] = 0.0;
+                py[b] = 0.0;
+                th[b] = 0.0;
+            }
+
+            for (std::size_t i = 0; i < N; ++i) {
+                const double L = link_lengths[i];
+                const double* qi = q + i * batch + b0;
+
+                //joint origin is the position before advancing along link i
+                if (joints_x && joints_y) {
+                    double* jx = joints_x + i * batch + b0;
+                    double* jy = joints_y + i * batch + b0;
+                    for (std::size_t b = 0; b < n; ++b) {
+                        jx[b] = px[b];
+                        jy[b] = py[b];
+                    }
+                }
+
+                //same convention as forward_kinematics: joint i rotates by the
+                //cumulative angle q1 + ... + qi relative to the previous link
+                for (std::size_t b = 0; b < n; ++b) {
+                    cumulative[b] += qi[b];
+                    th[b] += cumulative[b];
+                    px[b] += L * std::cos(th[b]);
+                    py[b] += L * std::sin(th[b]);
+                }
+            }
         }
-
-        return positions;
     }
 
-    // 2xN Jacobian represented as N column vectors (each Vector2 is a column)
-    std::vector<math::Vector2> jacobian(const std::vector<double>& q) const {
-        using math::Vector2;
+private:
+    //joint origins, plus the end effector when with_tip is set
+    void chain_points(const std::vector<double>& q,
+                      std::vector<math::Vector2>& positions,
+                      bool with_tip) const {
+        using math::SE2Compact;
+        using math::SO2;
 
         assert(q.size() == link_lengths.size());
 
-        // joint positions and end-effector position
-        auto joints = joint_positions(q);
-        auto T_end = forward_kinematics(q);
-        Vector2 p_end = T_end * Vector2{0.0, 0.0};
+        positions.resize(q.size() + (with_tip ? 1 : 0));
 
-        std::vector<Vector2> J;
-        J.reserve(q.size());
+        SE2Compact T; //identity
+        SO2 cumulative;
 
-        for (size_t j = 0; j < q.size(); ++j) {
-            const Vector2& pj = joints[j];
+        for (size_t i = 0; i < link_lengths.size(); ++i) {
+            // move to joint i frame; store its origin before translating along the link
+            cumulative = cumulative * SO2::from_angle(q[i]);
+            T.R = T.R * cumulative;
+            positions[i] = T.t;
 
-            // r = p_end - pj
-            Vector2 r{
-                p_end.x - pj.x,
-                p_end.y - pj.y
-            };
+            // advance to end of link i
+            double L = link_lengths[i];
+            T.t.x += L * T.R.c;
+            T.t.y += L * T.R.s;
 
-            //z-hat cross r -> (-r_y, r_x)
-            Vector2 col{
-                -r.y,
-                r.x
-            };
+            if ((i & kRenormalizeMask) == kRenormalizeMask) {
+                cumulative.renormalize();
+                T.renormalize();
+            }
+        }
 
-            J.push_back(col);
-         }
-         return J;
+        if (with_tip)
+            positions[q.size()] = T.t;
     }
 };
 
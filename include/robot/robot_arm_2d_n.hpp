@@ -0,0 +1,95 @@
+#pragma once
+
+#include "math/se2.hpp"
+#include "robot/jacobian_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace robot {
+
+//Planar serial arm with a compile-time number of links. Same conventions as
+//RobotArm2d (joint i rotates by q1 + ... + qi relative to the previous link),
+//but all state lives in std::array so nothing touches the heap and the loops
+//over the chain have a constant trip count the compiler can unroll.
+template <std::size_t N>
+struct RobotArm2dN {
+    static_assert(N > 0, "RobotArm2dN needs at least one link");
+
+    using Config = std::array<double, N>;
+    using Points = std::array<math::Vector2, N>;
+
+    std::array<double, N> link_lengths{};
+
+    constexpr RobotArm2dN() = default;
+
+    constexpr explicit RobotArm2dN(const std::array<double, N>& lengths)
+        : link_lengths(lengths) {}
+
+    static constexpr std::size_t dof() { return N; }
+
+    //maximum distance from the base the end effector can reach
+    constexpr double reach() const {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < N; ++i)
+            sum += link_lengths[i];
+        return sum;
+    }
+
+    //equivalent dynamically sized arm
+    RobotArm2d to_dynamic() const {
+        RobotArm2d arm{};
+        arm.link_lengths.assign(link_lengths.begin(), link_lengths.end());
+        return arm;
+    }
+
+    //Fused kernel: end-effector pose, joint origins and Jacobian columns in one
+    //pass of the suffix-sum kernel shared with Jacobian2d, mirroring
+    //RobotArm2d::kinematics (columns are dp/dc)
+    math::SE2 kinematics(const Config& q, Points& joints, Points& J) const {
+        using math::Matrix2;
+        using math::SE2;
+        using math::Vector2;
+
+        const Jacobian2d::Tip tip = Jacobian2d::kernel(link_lengths.data(), q.data(), N,
+                                                       JointAngles::Cumulative,
+                                                       &J[0].x, &J[0].y, 2);
+
+        for (std::size_t j = 0; j < N; ++j)
+            joints[j] = Vector2{tip.p.x - J[j].y, tip.p.y + J[j].x};
+
+        return SE2(Matrix2(tip.c, -tip.s,
+                           tip.s, tip.c), tip.p);
+    }
+
+    math::SE2 forward_kinematics(const Config& q) const {
+        using math::Matrix2;
+        using math::SE2;
+
+        Points J;
+        const Jacobian2d::Tip tip = Jacobian2d::kernel(link_lengths.data(), q.data(), N,
+                                                       JointAngles::Cumulative,
+                                                       &J[0].x, &J[0].y, 2);
+        return SE2(Matrix2(tip.c, -tip.s,
+                           tip.s, tip.c), tip.p);
+    }
+
+    //world-frame positions of each joint origin
+    Points joint_positions(const Config& q) const {
+        Points joints;
+        Points J;
+        kinematics(q, joints, J);
+        return joints;
+    }
+
+    //2xN Jacobian represented as N column vectors
+    Points jacobian(const Config& q) const {
+        Points joints;
+        Points J;
+        kinematics(q, joints, J);
+        return J;
+    }
+};
+
+}//namespace robot
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "math/se3.hpp"
+#include <vector>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+namespace robot {
+
+//Standard Denavit-Hartenberg parameters of one revolute joint. The link
+//transform is Rz(theta + q) * Tz(d) * Tx(a) * Rx(alpha), with the joint
+//rotating about the z axis of the previous frame.
+struct DHParams {
+    double a{0.0};     //link length along x_i
+    double alpha{0.0}; //link twist about x_i
+    double d{0.0};     //link offset along z_i-1
+    double theta{0.0}; //joint angle offset
+};
+
+//One column of the 6xN geometric Jacobian: end-effector linear and angular
+//velocity per unit rate of one joint, in the world frame.
+struct JacobianColumn3d {
+    math::Vector3 linear;
+    math::Vector3 angular;
+};
+
+//Spatial serial arm of revolute joints described by DH parameters.
+struct RobotArm3d {
+    explicit RobotArm3d(std::initializer_list<DHParams> params)
+        : RobotArm3d(std::vector<DHParams>(params)) {}
+
+    explicit RobotArm3d(const std::vector<DHParams>& params)
+        : links_(params) {
+        //everything except the joint rotation is constant, so the twist
+        //cos/sin are computed once here instead of on every evaluation
+        fixed_.reserve(params.size());
+        for (const auto& p : params)
+            fixed_.push_back(Link{p.a, p.d, std::cos(p.alpha), std::sin(p.alpha), p.theta});
+    }
+
+    std::size_t dof() const { return links_.size(); }
+
+    const std::vector<DHParams>& links() const { return links_; }
+
+    //end-effector pose
+    math::SE3 forward_kinematics(const std::vector<double>& q) const {
+        assert(q.size() == dof());
+
+        math::SE3 T; //identity
+        for (std::size_t i = 0; i < fixed_.size(); ++i)
+            apply_link(T, fixed_[i], q[i]);
+        return T;
+    }
+
+    //as above; frames[i] receives the world pose of the frame joint i rotates
+    //in (its z axis is the joint axis, its origin lies on the axis)
+    math::SE3 forward_kinematics(const std::vector<double>& q,
+                                 std::vector<math::SE3>& frames) const {
+        assert(q.size() == dof());
+
+        frames.resize(fixed_.size());
+
+        math::SE3 T;
+        for (std::size_t i = 0; i < fixed_.size(); ++i) {
+            frames[i] = T;
+            apply_link(T, fixed_[i], q[i]);
+        }
+        return T;
+    }
+
+    //6xN geometric Jacobian as N columns
+    std::vector<JacobianColumn3d> jacobian(const std::vector<double>& q) const {
+        std::vector<math::SE3> frames;
+        std::vector<JacobianColumn3d> J;
+        kinematics(q, frames, J);
+        return J;
+    }
+
+    //Fused kernel: end-effector pose, joint frames and Jacobian columns from a
+    //single pass over the chain. Column j is z_j x (p_end - o_j) and z_j, the
+    //spatial counterpart of RobotArm2d::kinematics.
+    math::SE3 kinematics(const std::vector<double>& q,
+                         std::vector<math::SE3>& frames,
+                         std::vector<JacobianColumn3d>& J) const {
+        using math::Vector3;
+
+        const math::SE3 T = forward_kinematics(q, frames);
+        J.resize(frames.size());
+
+        for (std::size_t j = 0; j < frames.size(); ++j) {
+            const math::Matrix3& R = frames[j].R;
+            const Vector3 z{R.m02, R.m12, R.m22};
+            J[j].linear = z.cross(T.t - frames[j].t);
+            J[j].angular = z;
+        }
+        return T;
+    }
+
+    //Batched forward kinematics over `batch` configurations. q is joint-major
+    //like RobotArm2d::forward_kinematics_batch: q[i * batch + b] is joint i of
+    //configuration b. poses[b] receives forward_kinematics(q_b).
+    void forward_kinematics_batch(const double* q, std::size_t batch,
+                                  math::SE3* poses) const {
+        //each pose stays in registers across the whole chain; writing the
+        //running poses back per joint costs more than the strided q reads
+        const std::size_t N = fixed_.size();
+
+        for (std::size_t b = 0; b < batch; ++b) {
+            math::SE3 T;
+            for (std::size_t i = 0; i < N; ++i)
+                apply_link(T, fixed_[i], q[i * batch + b]);
+            poses[b] = T;
+        }
+    }
+
+private:
+    //constant part of a DH link
+    struct Link {
+        double a, d;
+        double ca, sa; //cos/sin of alpha
+        double theta;
+    };
+
+    //T = T * Rz(theta + q) * Tz(d) * Tx(a) * Rx(alpha), expanded on the columns
+    //of R: the joint rotation mixes x/y, the twist mixes the rotated y with z.
+    static void apply_link(math::SE3& T, const Link& link, double q) {
+        using math::Vector3;
+
+        const double c = std::cos(link.theta + q);
+        const double s = std::sin(link.theta + q);
+
+        math::Matrix3& R = T.R;
+        const Vector3 x{R.m00, R.m10, R.m20};
+        const Vector3 y{R.m01, R.m11, R.m21};
+        const Vector3 z{R.m02, R.m12, R.m22};
+
+        const Vector3 u = x * c + y * s;    //rotated x
+        const Vector3 v = y * c - x * s;    //rotated y
+        const Vector3 w = v * link.ca + z * link.sa;
+        const Vector3 n = z * link.ca - v * link.sa;
+
+        T.t = T.t + u * link.a + z * link.d;
+
+        R.m00 = u.x; R.m01 = w.x; R.m02 = n.x;
+        R.m10 = u.y; R.m11 = w.y; R.m12 = n.y;
+        R.m20 = u.z; R.m21 = w.z; R.m22 = n.z;
+    }
+
+    std::vector<DHParams> links_;
+    std::vector<Link> fixed_;
+};
+
+}//namespace robot
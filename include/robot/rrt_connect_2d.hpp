@@ -0,0 +1,390 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+
+namespace robot {
+
+//Joint-space path found by RRTConnect2d
+struct RRTPath2d {
+    size_t dof = 0;
+    bool found = false;
+    std::vector<double> q;   //waypoints x dof, row-major, start first
+    size_t nodes = 0;        //tree nodes created
+    int iterations = 0;      //samples drawn
+    double seconds = 0.0;    //wall time until the trees connected or gave up
+
+    size_t size() const { return dof ? q.size() / dof : 0; }
+
+    const double* config(size_t i) const { return q.data() + i * dof; }
+};
+
+//One RRT in joint space: configurations in a fixed-capacity arena plus an
+//incremental k-d tree over them. All joints are continuous revolute joints
+//with angles kept in [-pi, pi); distances take the shorter way round each
+//joint circle.
+class RRTTree2d {
+public:
+    RRTTree2d(size_t dof, size_t capacity)
+        : dof_(dof), capacity_(capacity) {
+        //one allocation per buffer for the lifetime of the tree
+        q_.reserve(capacity * dof);
+        parent_.reserve(capacity);
+        left_.reserve(capacity);
+        right_.reserve(capacity);
+    }
+
+    void clear() {
+        q_.clear();
+        parent_.clear();
+        left_.clear();
+        right_.clear();
+    }
+
+    size_t size() const { return parent_.size(); }
+    bool full() const { return size() >= capacity_; }
+
+    const double* config(int32_t i) const { return q_.data() + static_cast<size_t>(i) * dof_; }
+    int32_t parent(int32_t i) const { return parent_[i]; }
+
+    //appends q (already wrapped) with the given parent; returns its index or
+    //-1 when the arena is full
+    int32_t add(const double* q, int32_t parent) {
+        if (full())
+            return -1;
+
+        const int32_t index = static_cast<int32_t>(size());
+        q_.insert(q_.end(), q, q + dof_);
+        parent_.push_back(parent);
+        left_.push_back(-1);
+        right_.push_back(-1);
+
+        //descend to the leaf slot; split dimension cycles with depth
+        if (index > 0) {
+            int32_t node = 0;
+            for (size_t depth = 0; ; ++depth) {
+                const size_t d = depth % dof_;
+                std::vector<int32_t>& child = (q[d] >= config(node)[d]) ? right_ : left_;
+                if (child[node] < 0) {
+                    child[node] = index;
+                    break;
+                }
+                node = child[node];
+            }
+        }
+        return index;
+    }
+
+    //index of the stored configuration closest to q (wrapped distance)
+    int32_t nearest(const double* q) const {
+        int32_t best = -1;
+        double best_d2 = std::numeric_limits<double>::infinity();
+        if (size() > 0)
+            search(0, 0, q, best, best_d2);
+        return best;
+    }
+
+    //signed shortest angular difference b - a, in [-pi, pi)
+    static double wrap_diff(double a, double b) {
+        return wrap(b - a);
+    }
+
+    static double wrap(double a) {
+        return a - 2.0 * M_PI * std::floor((a + M_PI) / (2.0 * M_PI));
+    }
+
+    static double distance2(const double* a, const double* b, size_t dof) {
+        double d2 = 0.0;
+        for (size_t i = 0; i < dof; ++i) {
+            double d = wrap_diff(a[i], b[i]);
+            d2 += d * d;
+        }
+        return d2;
+    }
+
+private:
+    void search(int32_t node, size_t depth, const double* x, int32_t& best, double& best_d2) const {
+        const double* p = config(node);
+        const double d2 = distance2(x, p, dof_);
+        if (d2 < best_d2) {
+            best_d2 = d2;
+            best = node;
+        }
+
+        const size_t d = depth % dof_;
+        const double v = p[d];
+        const bool right_side = x[d] >= v;
+        const int32_t near_child = right_side ? right_[node] : left_[node];
+        const int32_t far_child = right_side ? left_[node] : right_[node];
+
+        if (near_child >= 0)
+            search(near_child, depth + 1, x, best, best_d2);
+
+        if (far_child >= 0) {
+            //distance along joint d from x to the other half circle, which
+            //can also be reached through the +-pi seam
+            const double bound = right_side ? std::min(x[d] - v, M_PI - x[d])
+                                            : std::min(v - x[d], x[d] + M_PI);
+            if (bound * bound < best_d2)
+                search(far_child, depth + 1, x, best, best_d2);
+        }
+    }
+
+    size_t dof_;
+    size_t capacity_;
+    std::vector<double> q_;
+    std::vector<int32_t> parent_;
+    std::vector<int32_t> left_, right_; //k-d tree children, -1 if none
+};
+
+//Bidirectional RRT-Connect in the joint space of a RobotArm2d. The collision
+//checker is any callable bool(const double* q) that returns true when the
+//configuration is free; edges are checked at check_resolution (max joint
+//step between checked configurations). In parallel mode the checker is
+//called from several threads at once and must be safe for that.
+struct RRTConnect2d {
+    double step = 0.3;               //max extension per tree step (rad, joint-space norm)
+    double check_resolution = 0.05;  //max joint-space distance between edge checks
+    size_t max_nodes = 50000;        //arena capacity per tree
+    int max_iters = 20000;           //samples before giving up
+    unsigned seed = 1;
+
+    template <typename Valid>
+    RRTPath2d solve(const RobotArm2d& arm,
+                    const std::vector<double>& start,
+                    const std::vector<double>& goal,
+                    Valid&& valid,
+                    const std::atomic<bool>* cancel = nullptr) const
+    {
+        const size_t N = arm.link_lengths.size();
+        RRTTree2d a(N, max_nodes), b(N, max_nodes);
+        return solve(start, goal, valid, a, b, seed, cancel);
+    }
+
+    //Grows pool.size() independent tree pairs with different seeds and
+    //returns the first path found; the other searches stop at their next
+    //iteration.
+    template <typename Valid>
+    RRTPath2d solve_parallel(const RobotArm2d& arm,
+                             const std::vector<double>& start,
+                             const std::vector<double>& goal,
+                             Valid&& valid,
+                             util::ThreadPool& pool) const
+    {
+        const size_t N = arm.link_lengths.size();
+        const size_t K = pool.size();
+
+        auto t0 = std::chrono::steady_clock::now();
+
+        std::atomic<bool> solved{false};
+        std::atomic<int> winner{-1};
+        std::vector<RRTPath2d> results(K);
+
+        pool.run(K, [&](size_t k, size_t) {
+            if (solved.load(std::memory_order_relaxed))
+                return;
+
+            RRTTree2d a(N, max_nodes), b(N, max_nodes);
+            results[k] = solve(start, goal, valid, a, b,
+                               seed + static_cast<unsigned>(k) * 7919u, &solved);
+
+            int none = -1;
+            if (results[k].found && winner.compare_exchange_strong(none, static_cast<int>(k)))
+                solved.store(true, std::memory_order_relaxed);
+        });
+
+        RRTPath2d out;
+        out.dof = N;
+        int w = winner.load();
+        if (w >= 0)
+            out = std::move(results[w]);
+
+        //report the combined effort of all searches
+        out.nodes = 0;
+        out.iterations = 0;
+        for (const auto& r : results) {
+            out.nodes += r.nodes;
+            out.iterations += r.iterations;
+        }
+        out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        return out;
+    }
+
+private:
+    enum class Extend { Reached, Advanced, Trapped };
+
+    template <typename Valid>
+    RRTPath2d solve(const std::vector<double>& start,
+                    const std::vector<double>& goal,
+                    Valid& valid,
+                    RRTTree2d& start_tree,
+                    RRTTree2d& goal_tree,
+                    unsigned rng_seed,
+                    const std::atomic<bool>* cancel) const
+    {
+        auto t0 = std::chrono::steady_clock::now();
+
+        const size_t N = start.size();
+        RRTPath2d out;
+        out.dof = N;
+
+        std::vector<double> qs(N), qg(N), q_rand(N), q_new(N);
+        for (size_t i = 0; i < N; ++i) {
+            qs[i] = RRTTree2d::wrap(start[i]);
+            qg[i] = RRTTree2d::wrap(goal[i]);
+        }
+
+        auto finish = [&]() -> RRTPath2d& {
+            out.nodes = start_tree.size() + goal_tree.size();
+            out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            return out;
+        };
+
+        if (!valid(qs.data()) || !valid(qg.data()))
+            return finish();
+
+        start_tree.clear();
+        goal_tree.clear();
+        start_tree.add(qs.data(), -1);
+        goal_tree.add(qg.data(), -1);
+
+        //the trees may already see each other
+        if (edge_free(qs.data(), qg.data(), N, valid, q_new)) {
+            extract(start_tree, 0, goal_tree, 0, start, out);
+            out.found = true;
+            return finish();
+        }
+
+        std::mt19937 rng(rng_seed);
+        std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+        RRTTree2d* ta = &start_tree;
+        RRTTree2d* tb = &goal_tree;
+
+        for (int iter = 0; iter < max_iters; ++iter) {
+            out.iterations = iter + 1;
+            if (cancel && cancel->load(std::memory_order_relaxed))
+                break;
+            if (ta->full() || tb->full())
+                break;
+
+            for (auto& v : q_rand) v = angle(rng);
+
+            int32_t a_new = -1;
+            if (extend(*ta, q_rand.data(), valid, q_new, a_new) != Extend::Trapped) {
+                //pull the other tree toward the new node until it arrives or is blocked
+                int32_t b_new = -1;
+                Extend e;
+                do {
+                    e = extend(*tb, ta->config(a_new), valid, q_new, b_new);
+                } while (e == Extend::Advanced);
+
+                if (e == Extend::Reached) {
+                    if (ta == &start_tree)
+                        extract(start_tree, a_new, goal_tree, b_new, start, out);
+                    else
+                        extract(start_tree, b_new, goal_tree, a_new, start, out);
+                    out.found = true;
+                    return finish();
+                }
+            }
+            std::swap(ta, tb);
+        }
+        return finish();
+    }
+
+    //one step of at most `step` from the nearest node of tree toward target
+    template <typename Valid>
+    Extend extend(RRTTree2d& tree, const double* target, Valid& valid,
+                  std::vector<double>& q_new, int32_t& added) const
+    {
+        const size_t N = q_new.size();
+        const int32_t near = tree.nearest(target);
+        const double* qn = tree.config(near);
+
+        const double dist = std::sqrt(RRTTree2d::distance2(qn, target, N));
+        const bool reaches = dist <= step;
+        const double t = reaches ? 1.0 : step / dist;
+        for (size_t i = 0; i < N; ++i)
+            q_new[i] = RRTTree2d::wrap(qn[i] + t * RRTTree2d::wrap_diff(qn[i], target[i]));
+
+        std::vector<double>& probe = scratch(N);
+        if (!edge_free(qn, q_new.data(), N, valid, probe))
+            return Extend::Trapped;
+
+        added = tree.add(q_new.data(), near);
+        if (added < 0)
+            return Extend::Trapped;
+        return reaches ? Extend::Reached : Extend::Advanced;
+    }
+
+    //checks the configurations along a -> b (b included, a assumed free)
+    template <typename Valid>
+    bool edge_free(const double* a, const double* b, size_t N, Valid& valid,
+                   std::vector<double>& probe) const
+    {
+        const double len = std::sqrt(RRTTree2d::distance2(a, b, N));
+        const int steps = std::max(1, static_cast<int>(std::ceil(len / check_resolution)));
+
+        probe.resize(N);
+        for (int k = 1; k <= steps; ++k) {
+            const double t = static_cast<double>(k) / steps;
+            for (size_t i = 0; i < N; ++i)
+                probe[i] = RRTTree2d::wrap(a[i] + t * RRTTree2d::wrap_diff(a[i], b[i]));
+            if (!valid(static_cast<const double*>(probe.data())))
+                return false;
+        }
+        return true;
+    }
+
+    //per-thread probe buffer for edge checks inside extend
+    static std::vector<double>& scratch(size_t N) {
+        thread_local std::vector<double> buf;
+        buf.resize(N);
+        return buf;
+    }
+
+    //start root .. a, then b .. goal root; angles are unwrapped so that
+    //consecutive waypoints differ by the short way round
+    static void extract(const RRTTree2d& start_tree, int32_t a,
+                        const RRTTree2d& goal_tree, int32_t b,
+                        const std::vector<double>& start, RRTPath2d& out)
+    {
+        const size_t N = out.dof;
+
+        std::vector<int32_t> chain;
+        for (int32_t i = a; i >= 0; i = start_tree.parent(i))
+            chain.push_back(i);
+        std::reverse(chain.begin(), chain.end());
+
+        out.q.clear();
+        out.q.insert(out.q.end(), start.begin(), start.end());
+
+        auto append = [&](const double* c) {
+            //indexed rather than through a pointer: push_back may reallocate
+            const size_t prev = out.q.size() - N;
+            if (RRTTree2d::distance2(out.q.data() + prev, c, N) == 0.0)
+                return; //the connecting node is in both trees
+            for (size_t i = 0; i < N; ++i) {
+                double v = out.q[prev + i] + RRTTree2d::wrap_diff(out.q[prev + i], c[i]);
+                out.q.push_back(v);
+            }
+        };
+
+        for (size_t k = 1; k < chain.size(); ++k)
+            append(start_tree.config(chain[k]));
+        for (int32_t i = b; i >= 0; i = goal_tree.parent(i))
+            append(goal_tree.config(i));
+    }
+};
+
+} // namespace robot
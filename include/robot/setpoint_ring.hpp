@@ -0,0 +1,188 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace robot {
+
+//Single-producer/single-consumer lock-free ring of joint setpoints, each a
+//fixed block of dof doubles. Intended to hand plans from a planning thread to
+//a controller thread without locks or per-setpoint allocation: all storage is
+//allocated once on construction.
+//
+//The producer either copies a setpoint in with try_push or writes it in place
+//(try_claim, fill, commit); the consumer mirrors that with try_pop or
+//try_front/release. Exactly one thread may act as producer and one as
+//consumer at a time. The read and write indices sit on separate cache lines,
+//each side keeps a cached copy of the other's index on its own line so the
+//other side's line is only read when the ring looks full/empty, and every
+//slot is padded to whole cache lines so neighbouring slots do not
+//false-share.
+class SetpointRing {
+public:
+    //capacity is rounded up to a power of two
+    SetpointRing(size_t dof, size_t capacity)
+        : dof_(dof),
+          stride_((dof + kLineDoubles - 1) / kLineDoubles * kLineDoubles),
+          capacity_(round_up_pow2(capacity)),
+          mask_(capacity_ - 1)
+    {
+        assert(dof > 0 && capacity > 0);
+        storage_.resize(capacity_ * stride_ + kLineDoubles);
+        const uintptr_t p = reinterpret_cast<uintptr_t>(storage_.data());
+        const size_t misalign = (p % kCacheLine) / sizeof(double);
+        slots_ = storage_.data() + (misalign ? kLineDoubles - misalign : 0);
+    }
+
+    SetpointRing(const SetpointRing&) = delete;
+    SetpointRing& operator=(const SetpointRing&) = delete;
+
+    size_t dof() const { return dof_; }
+    size_t capacity() const { return capacity_; }
+
+    //setpoints currently queued; exact only when called from either end
+    //while the other is idle
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    // ---- producer ----
+
+    //slot to write the next setpoint into, or nullptr if the ring is full;
+    //publish it with commit()
+    double* try_claim() {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - producer_tail_ == capacity_) {
+            producer_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - producer_tail_ == capacity_)
+                return nullptr;
+        }
+        return slots_ + (head & mask_) * stride_;
+    }
+
+    void commit() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    //copies q[0..dof) in; false if the ring is full
+    bool try_push(const double* q) {
+        double* slot = try_claim();
+        if (!slot)
+            return false;
+        for (size_t i = 0; i < dof_; ++i)
+            slot[i] = q[i];
+        commit();
+        return true;
+    }
+
+    //no more setpoints will follow; the consumer still drains what is queued
+    void close() { closed_.store(true, std::memory_order_release); }
+
+    // ---- consumer ----
+
+    //oldest queued setpoint, or nullptr if the ring is empty; it stays valid
+    //until release()
+    const double* try_front() {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (consumer_head_ == tail) {
+            consumer_head_ = head_.load(std::memory_order_acquire);
+            if (consumer_head_ == tail)
+                return nullptr;
+        }
+        return slots_ + (tail & mask_) * stride_;
+    }
+
+    void release() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    //copies the oldest setpoint to q[0..dof); false if the ring is empty
+    bool try_pop(double* q) {
+        const double* slot = try_front();
+        if (!slot)
+            return false;
+        for (size_t i = 0; i < dof_; ++i)
+            q[i] = slot[i];
+        release();
+        return true;
+    }
+
+    //the producer has closed the ring and everything queued was consumed
+    bool finished() const {
+        return closed_.load(std::memory_order_acquire) &&
+               tail_.load(std::memory_order_relaxed) == head_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+    static constexpr size_t kLineDoubles = kCacheLine / sizeof(double);
+
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    const size_t dof_;
+    const size_t stride_; //doubles per slot, a whole number of cache lines
+    const size_t capacity_;
+    const size_t mask_;
+    std::vector<double> storage_;
+    double* slots_ = nullptr; //cache-line aligned start within storage_
+
+    //each line is written by one side only: the producer's index with its
+    //cached copy of the consumer's, and vice versa
+    alignas(kCacheLine) std::atomic<size_t> head_{0}; //next slot to write
+    size_t producer_tail_ = 0;                         //producer's view of tail_
+
+    alignas(kCacheLine) std::atomic<size_t> tail_{0}; //next slot to read
+    size_t consumer_head_ = 0;                         //consumer's view of head_
+
+    alignas(kCacheLine) std::atomic<bool> closed_{false};
+};
+
+//Planner-side adapter: a callable that streaming planners such as
+//CartesianPlanner2d::stream emit into directly, so setpoints go straight
+//from the planner's buffers into the ring. While the ring is full it spins
+//briefly, then yields, until the consumer makes room; it gives up, stopping
+//the planner, once cancel is raised.
+struct SetpointStream {
+    SetpointRing& ring;
+    const std::atomic<bool>* cancel = nullptr;
+
+    explicit SetpointStream(SetpointRing& ring_, const std::atomic<bool>* cancel_ = nullptr)
+        : ring(ring_), cancel(cancel_) {}
+
+    //q[0..dof)
+    bool push(const double* q) const {
+        for (int spins = 0; !ring.try_push(q); ) {
+            if (cancel && cancel->load(std::memory_order_relaxed))
+                return false;
+            //saturates, so a long wait cannot overflow the counter
+            if (spins < kSpins)
+                ++spins;
+            else
+                std::this_thread::yield();
+        }
+        return true;
+    }
+
+    bool operator()(const std::vector<double>& q) const {
+        assert(q.size() == ring.dof());
+        return push(q.data());
+    }
+
+    //any waypoint type exposing its joint vector as .q (CartesianWaypoint2d)
+    template <typename Waypoint>
+    auto operator()(const Waypoint& wp) const -> decltype(wp.q.data(), bool()) {
+        return (*this)(wp.q);
+    }
+
+    static constexpr int kSpins = 64;
+};
+
+} // namespace robot
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UTIL_MAPPED_FILE_MMAP 1
+#endif
+
+namespace util {
+
+//Read-only view of a whole file. On POSIX systems the file is memory-mapped,
+//so opening costs a few system calls regardless of its size and pages are
+//read from the page cache on first touch; elsewhere it is read into memory.
+//The data is page-aligned (mmap) or new-aligned, so fixed-layout headers and
+//arrays of 8-byte types can be read in place at offsets aligned to them.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            mapped_ = std::exchange(other.mapped_, false);
+            buffer_ = std::move(other.buffer_);
+        }
+        return *this;
+    }
+
+    //Returns false, leaving the view closed, if path cannot be read. An
+    //empty file opens as an empty view.
+    bool open(const std::string& path) {
+        close();
+#ifdef UTIL_MAPPED_FILE_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        const size_t size = static_cast<size_t>(st.st_size);
+        if (size > 0) {
+            void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                return false;
+            }
+            data_ = static_cast<const uint8_t*>(p);
+            mapped_ = true;
+        }
+        ::close(fd); //the mapping keeps the file referenced
+        size_ = size;
+        return true;
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            return false;
+        const std::streamoff size = in.tellg();
+        std::vector<uint64_t> buffer((static_cast<size_t>(size) + 7) / 8);
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(buffer.data()), size);
+        if (!in)
+            return false;
+        buffer_ = std::move(buffer);
+        data_ = reinterpret_cast<const uint8_t*>(buffer_.data());
+        size_ = static_cast<size_t>(size);
+        return true;
+#endif
+    }
+
+    void close() {
+#ifdef UTIL_MAPPED_FILE_MMAP
+        if (mapped_)
+            ::munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        buffer_.clear();
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool mapped() const { return mapped_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<uint64_t> buffer_; //fallback storage, 8-byte aligned
+};
+
+} // namespace util
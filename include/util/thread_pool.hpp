@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+//Fixed set of worker threads that execute index-parallel jobs.
+//run(count, fn) calls fn(index, slot) once for every index in [0, count),
+//where slot in [0, size()) identifies the executing thread so callers can
+//keep per-thread scratch (e.g. one IK workspace per slot). The calling
+//thread takes part as slot 0, so a pool of size 1 runs everything inline.
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency()) {
+        threads = std::max<std::size_t>(1, threads);
+        workers_.reserve(threads - 1);
+        for (std::size_t slot = 1; slot < threads; ++slot)
+            workers_.emplace_back([this, slot] { worker_loop(slot); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : workers_)
+            t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //number of execution slots, including the calling thread
+    std::size_t size() const { return workers_.size() + 1; }
+
+    //Blocks until fn has run for every index. Indices are handed out
+    //dynamically, so uneven per-index cost balances across threads.
+    //If fn throws, no further indices are started, run waits for the calls
+    //already in flight and rethrows the first exception on the caller.
+    //Must not be called from inside a job on the same pool (it would wait on
+    //itself); fn may run jobs on a different pool.
+    template <typename F>
+    void run(std::size_t count, F&& fn) {
+        assert(running() != this && "ThreadPool::run called from inside one of its own jobs");
+        if (count == 0)
+            return;
+
+        std::lock_guard<std::mutex> serial(run_mutex_);
+
+        auto* ctx = &fn;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = [](void* c, std::size_t index, std::size_t slot) {
+                (*static_cast<decltype(ctx)>(c))(index, slot);
+            };
+            ctx_ = const_cast<void*>(static_cast<const void*>(ctx));
+            count_ = count;
+            next_.store(0, std::memory_order_relaxed);
+            busy_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        work(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return busy_ == 0; });
+        if (error_)
+            std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+private:
+    //pool whose job the current thread is executing, if any
+    static const ThreadPool*& running() {
+        static thread_local const ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    void work(std::size_t slot) {
+        const ThreadPool* outer = std::exchange(running(), this);
+        for (;;) {
+            std::size_t index = next_.fetch_add(1, std::memory_order_relaxed);
+            if (index >= count_)
+                break;
+            try {
+                job_(ctx_, index, slot);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_)
+                    error_ = std::current_exception();
+                next_.store(count_, std::memory_order_relaxed);
+                break;
+            }
+        }
+        running() = outer;
+    }
+
+    void worker_loop(std::size_t slot) {
+        std::size_t seen = 0;
+        for (;;) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_)
+                return;
+            seen = generation_;
+            lock.unlock();
+
+            work(slot);
+
+            lock.lock();
+            if (--busy_ == 0)
+                done_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+
+    std::mutex run_mutex_; //serialises concurrent run() calls
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    //current job, published under mutex_
+    void (*job_)(void*, std::size_t, std::size_t) = nullptr;
+    void* ctx_ = nullptr;
+    std::size_t count_ = 0;
+    std::exception_ptr error_; //first exception thrown by the current job
+    std::atomic<std::size_t> next_{0};
+    std::size_t busy_ = 0;
+    std::size_t generation_ = 0;
+    bool stop_ = false;
+};
+
+} //namespace util
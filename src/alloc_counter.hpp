@@ -0,0 +1,89 @@
+#pragma once
+
+// Heap allocation counting shared by the tests and benchmarks.
+//
+// Include from exactly one translation unit per executable: it replaces the
+// global operator new/delete, every form of them (scalar and array, aligned,
+// nothrow, sized), so allocations made through any of them are counted.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace alloc_counter {
+
+inline std::atomic<size_t>& count() {
+    static std::atomic<size_t> n{0};
+    return n;
+}
+
+//heap allocations made so far by this process
+inline size_t allocations() {
+    return count().load(std::memory_order_relaxed);
+}
+
+//kept out of line: once a replaced operator delete is inlined next to a
+//new-expression GCC reports its free() as mismatched (-Wmismatched-new-delete)
+[[gnu::noinline]] inline void* allocate(std::size_t size, std::size_t align) noexcept {
+    count().fetch_add(1, std::memory_order_relaxed);
+    if (size == 0)
+        size = 1;
+    if (align <= alignof(std::max_align_t))
+        return std::malloc(size);
+    //aligned_alloc wants a size that is a multiple of the alignment
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+}
+
+[[gnu::noinline]] inline void release(void* p) noexcept {
+    std::free(p);
+}
+
+inline void* allocate_or_throw(std::size_t size, std::size_t align) {
+    if (void* p = allocate(size, align))
+        return p;
+    throw std::bad_alloc();
+}
+
+} // namespace alloc_counter
+
+// ----------------------------------------------
+// Global allocation counting
+// ----------------------------------------------
+void* operator new(std::size_t size) {
+    return alloc_counter::allocate_or_throw(size, 0);
+}
+void* operator new[](std::size_t size) {
+    return alloc_counter::allocate_or_throw(size, 0);
+}
+void* operator new(std::size_t size, std::align_val_t align) {
+    return alloc_counter::allocate_or_throw(size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return alloc_counter::allocate_or_throw(size, static_cast<std::size_t>(align));
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return alloc_counter::allocate(size, 0);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return alloc_counter::allocate(size, 0);
+}
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return alloc_counter::allocate(size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return alloc_counter::allocate(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* p) noexcept { alloc_counter::release(p); }
+void operator delete[](void* p) noexcept { alloc_counter::release(p); }
+void operator delete(void* p, std::size_t) noexcept { alloc_counter::release(p); }
+void operator delete[](void* p, std::size_t) noexcept { alloc_counter::release(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alloc_counter::release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alloc_counter::release(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alloc_counter::release(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alloc_counter::release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { alloc_counter::release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { alloc_counter::release(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { alloc_counter::release(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { alloc_counter::release(p); }
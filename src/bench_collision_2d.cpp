@@ -0,0 +1,176 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "bench_util.hpp"
+
+#include "geometry/collision_scene_2d.hpp"
+#include "geometry/sdf_2d.hpp"
+#include "robot/arm_clearance_2d.hpp"
+#include "robot/arm_collision_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+
+using geometry::Box2d;
+using geometry::Capsule2d;
+using geometry::Circle2d;
+using geometry::CollisionScene2d;
+using geometry::SignedDistanceField2d;
+using math::Vector2;
+using robot::ArmClearance2d;
+using robot::ArmCollision2d;
+using robot::ArmCollisionWorkspace2d;
+using robot::RobotArm2d;
+
+// Per-configuration arm collision checks against scenes of growing obstacle
+// count: grid broadphase vs brute force, and the threaded batch API. Signed
+// distance field construction and clearance queries.
+//   bench_collision_2d [--json out.json] [--min-time seconds]
+
+static constexpr size_t kPool = 1024; //configurations cycled through
+
+//obstacles of fixed size spread over a square whose area grows with their
+//count, so the local density (and the free share) stays about the same
+static CollisionScene2d make_scene(size_t count, std::mt19937& rng) {
+    const double extent = 0.25 * std::sqrt(static_cast<double>(count));
+    std::uniform_real_distribution<double> pos(-extent, extent);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    CollisionScene2d scene;
+    for (size_t i = 0; i < count; ++i) {
+        Vector2 c{pos(rng), pos(rng)};
+        if (i % 2 == 0)
+            scene.add(Circle2d{c, 0.05});
+        else
+            scene.add(Box2d{c, {0.05, 0.03}, angle(rng)});
+    }
+    scene.build();
+    return scene;
+}
+
+static void bench_arm_collision(bench::Runner& runner, std::mt19937& rng) {
+    const size_t N = 6;
+    RobotArm2d arm{0.3, 0.3, 0.2, 0.2, 0.1, 0.1};
+
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::vector<double> qs(kPool * N);
+    for (auto& v : qs) v = angle(rng);
+
+    for (size_t count : {16, 64, 256, 1024, 4096}) {
+        CollisionScene2d scene = make_scene(count, rng);
+        ArmCollision2d checker(arm, scene, 0.02);
+
+        long n_free = 0;
+        for (size_t b = 0; b < kPool; ++b)
+            n_free += checker(qs.data() + b * N) ? 1 : 0;
+
+        bench::Params params = {{"obstacles", static_cast<long>(count)},
+                                {"free_pct", 100 * n_free / static_cast<long>(kPool)}};
+        size_t k = 0;
+
+        ArmCollisionWorkspace2d ws;
+        std::vector<double> q(N);
+        runner.run("arm_collision_grid", params, [&] {
+            k = (k + 1) & (kPool - 1);
+            q.assign(qs.begin() + k * N, qs.begin() + (k + 1) * N);
+            bench::keep(checker.in_collision(q, ws));
+        });
+
+        runner.run("arm_collision_brute_force", params, [&] {
+            k = (k + 1) & (kPool - 1);
+            q.assign(qs.begin() + k * N, qs.begin() + (k + 1) * N);
+            arm.link_points(q, ws.points);
+            bool hit = false;
+            for (size_t i = 0; i + 1 < ws.points.size() && !hit; ++i)
+                hit = scene.intersects_brute_force(Capsule2d{ws.points[i], ws.points[i + 1], 0.02});
+            bench::keep(hit);
+        });
+    }
+}
+
+static void bench_batch(bench::Runner& runner, std::mt19937& rng) {
+    const size_t N = 6;
+    const size_t count = 4096;
+    RobotArm2d arm{0.3, 0.3, 0.2, 0.2, 0.1, 0.1};
+    CollisionScene2d scene = make_scene(1024, rng);
+    ArmCollision2d checker(arm, scene, 0.02);
+
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::vector<double> qs(count * N);
+    for (auto& v : qs) v = angle(rng);
+    std::vector<uint8_t> free(count);
+
+    for (size_t threads : {1, 2, 4}) {
+        util::ThreadPool pool(threads);
+        runner.run("arm_collision_batch",
+                   {{"obstacles", 1024L}, {"batch", static_cast<long>(count)},
+                    {"threads", static_cast<long>(threads)}},
+                   [&] {
+                       checker.check_batch(qs.data(), count, free.data(), pool);
+                       bench::keep(free[0]);
+                   },
+                   count);
+    }
+}
+
+static void bench_sdf(bench::Runner& runner, std::mt19937& rng) {
+    CollisionScene2d scene = make_scene(256, rng);
+    const geometry::AABB2d region = scene.bounds().inflated(0.5);
+
+    for (double res : {0.02, 0.01}) {
+        const long cells_side = static_cast<long>((region.max.x - region.min.x) / res);
+        for (size_t threads : {1, 2, 4}) {
+            util::ThreadPool pool(threads);
+            runner.run("sdf_build",
+                       {{"obstacles", 256L}, {"cells_per_side", cells_side},
+                        {"threads", static_cast<long>(threads)}},
+                       [&] {
+                           bench::keep(SignedDistanceField2d::build(scene, region, res, pool).at(0, 0));
+                       });
+        }
+    }
+
+    SignedDistanceField2d sdf = SignedDistanceField2d::build(scene, region, 0.01);
+
+    std::uniform_real_distribution<double> px(region.min.x, region.max.x);
+    std::uniform_real_distribution<double> py(region.min.y, region.max.y);
+    std::vector<Vector2> points(kPool);
+    for (auto& p : points) p = Vector2{px(rng), py(rng)};
+
+    size_t k = 0;
+    runner.run("sdf_distance", {{"obstacles", 256L}}, [&] {
+        k = (k + 1) & (kPool - 1);
+        bench::keep(sdf.distance(points[k]));
+    });
+    runner.run("sdf_gradient", {{"obstacles", 256L}}, [&] {
+        k = (k + 1) & (kPool - 1);
+        bench::keep(sdf.gradient(points[k]).x);
+    });
+
+    const size_t N = 6;
+    RobotArm2d arm{0.3, 0.3, 0.2, 0.2, 0.1, 0.1};
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::vector<std::vector<double>> qs(kPool, std::vector<double>(N));
+    for (auto& q : qs)
+        for (auto& v : q) v = angle(rng);
+
+    ArmClearance2d clearance(arm, sdf, 0.02);
+    std::vector<double> per_link;
+    std::vector<Vector2> link_points;
+    runner.run("arm_link_clearance", {{"N", static_cast<long>(N)}, {"res_um", 10000L}}, [&] {
+        k = (k + 1) & (kPool - 1);
+        bench::keep(clearance.link_clearance(qs[k], per_link, link_points));
+    });
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner("bench_collision_2d", argc, argv);
+    std::mt19937 rng(1);
+
+    bench_arm_collision(runner, rng);
+    bench_batch(runner, rng);
+    bench_sdf(runner, rng);
+
+    runner.finish();
+    return 0;
+}
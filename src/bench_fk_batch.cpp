@@ -0,0 +1,88 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "robot/robot_arm_2d.hpp"
+#include "math/se2.hpp"
+
+using robot::RobotArm2d;
+using math::Vector2;
+
+// Throughput of scalar vs batched forward kinematics.
+// Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+
+static RobotArm2d make_arm(size_t N) {
+    RobotArm2d arm{};
+    arm.link_lengths.assign(N, 1.0 / static_cast<double>(N));
+    return arm;
+}
+
+template <typename F>
+static double seconds(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main() {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    std::cout << std::setw(6) << "N"
+              << std::setw(10) << "B"
+              << std::setw(16) << "scalar ns/cfg"
+              << std::setw(16) << "batch ns/cfg"
+              << std::setw(10) << "speedup" << "\n";
+
+    double checksum = 0.0;
+
+    for (size_t B : {size_t{1000}, size_t{100000}}) {
+        for (size_t N : {2, 4, 8, 16, 32}) {
+            RobotArm2d arm = make_arm(N);
+
+            std::vector<double> q(N * B);
+            for (auto& v : q) v = angle(rng);
+
+            std::vector<double> x(B), y(B), theta(B);
+            std::vector<double> qb(N);
+
+            //keep total work roughly constant across the sweep
+            size_t reps = std::max<size_t>(1, 4000000 / (B * N));
+
+            double t_scalar = seconds([&] {
+                for (size_t r = 0; r < reps; ++r) {
+                    for (size_t b = 0; b < B; ++b) {
+                        for (size_t i = 0; i < N; ++i) qb[i] = q[i * B + b];
+                        auto T = arm.forward_kinematics(qb);
+                        checksum += T.t.x;
+                    }
+                }
+            });
+
+            double t_batch = seconds([&] {
+                for (size_t r = 0; r < reps; ++r) {
+                    arm.forward_kinematics_batch(q.data(), B, x.data(), y.data(), theta.data());
+                    checksum += x[r % B];
+                }
+            });
+
+            double ops = static_cast<double>(reps * B);
+            double ns_scalar = t_scalar * 1e9 / ops;
+            double ns_batch = t_batch * 1e9 / ops;
+
+            std::cout << std::setw(6) << N
+                      << std::setw(10) << B
+                      << std::setw(16) << std::fixed << std::setprecision(1) << ns_scalar
+                      << std::setw(16) << ns_batch
+                      << std::setw(10) << std::setprecision(2) << ns_scalar / ns_batch << "\n";
+        }
+    }
+
+    //prevents the optimiser from discarding the timed loops
+    std::cout << "checksum " << checksum << "\n";
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_util.hpp"
+
+#include "robot/ik_2d.hpp"
+#include "robot/ik_seed_db_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+
+using math::Vector2;
+using robot::IK2d;
+using robot::IK2dDamping;
+using robot::IK2dResult;
+using robot::IK2dWorkspace;
+using robot::IKSeedDatabase2d;
+using robot::IKSeedQuery2d;
+using robot::RobotArm2d;
+
+// IK warm starts from a k-d tree of precomputed solutions: database build,
+// load and nearest-neighbour queries, and IK2d::solve from a fixed q0 vs
+// from the nearest stored configuration, with either damping. The median
+// iteration count over the target set is recorded as a param.
+//   bench_ik_seed_db [--json out.json] [--min-time seconds]
+
+static constexpr size_t kPool = 1024; //targets cycled through
+
+int main(int argc, char** argv) {
+    bench::Runner runner("bench_ik_seed_db", argc, argv);
+    std::mt19937 rng(1);
+
+    RobotArm2d arm{0.3, 0.3, 0.2, 0.2, 0.1, 0.1};
+    const size_t N = arm.link_lengths.size();
+
+    for (size_t threads : {1, 4}) {
+        util::ThreadPool pool(threads);
+        runner.run("seed_db_build", {{"entries", 1L << 20}, {"threads", static_cast<long>(threads)}},
+                   [&] { bench::keep(IKSeedDatabase2d::build(arm, size_t{1} << 20, pool).point(0).x); },
+                   size_t{1} << 20);
+    }
+
+    const std::string path = "bench_ik_seed_db.bin";
+    IKSeedDatabase2d::build(arm, size_t{1} << 20).save(path);
+    runner.run("seed_db_load_mmap", {{"entries", 1L << 20}}, [&] {
+        IKSeedDatabase2d db;
+        IKSeedDatabase2d::load(path, db);
+        bench::keep(static_cast<double>(db.size()));
+    });
+
+    //reachable targets: forward kinematics of random configurations
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::vector<Vector2> targets(kPool);
+    for (auto& t : targets) {
+        std::vector<double> q(N);
+        for (auto& v : q) v = angle(rng);
+        t = arm.forward_kinematics(q) * Vector2{0.0, 0.0};
+    }
+    const std::vector<double> q0(N, 0.3);
+    IK2dWorkspace ws(arm);
+    IKSeedQuery2d query;
+
+    auto median = [](std::vector<long> v) {
+        std::sort(v.begin(), v.end());
+        return v[v.size() / 2];
+    };
+
+    std::vector<long> iters(kPool);
+    size_t k = 0;
+    for (IK2dDamping damping : {IK2dDamping::Fixed, IK2dDamping::Adaptive}) {
+        for (size_t i = 0; i < kPool; ++i)
+            iters[i] = IK2d::solve(arm, targets[i], q0, ws, 1e-6, 100, 1.0, 0.1, damping).iterations;
+        runner.run("ik_fixed_seed",
+                   {{"N", static_cast<long>(N)}, {"adaptive", damping == IK2dDamping::Adaptive ? 1L : 0L},
+                    {"median_iters", median(iters)}},
+                   [&] {
+                       k = (k + 1) & (kPool - 1);
+                       bench::keep(IK2d::solve(arm, targets[k], q0, ws, 1e-6, 100, 1.0, 0.1, damping).residual);
+                   });
+    }
+
+    for (long entries : {1L << 12, 1L << 16, 1L << 20}) {
+        IKSeedDatabase2d db;
+        if (entries == (1L << 20))
+            IKSeedDatabase2d::load(path, db);
+        else
+            db = IKSeedDatabase2d::build(arm, static_cast<size_t>(entries));
+
+        runner.run("seed_db_nearest", {{"entries", entries}, {"k", 1L}}, [&] {
+            k = (k + 1) & (kPool - 1);
+            bench::keep(static_cast<double>(db.nearest(targets[k], 1, query)));
+        });
+        runner.run("seed_db_nearest", {{"entries", entries}, {"k", 8L}}, [&] {
+            k = (k + 1) & (kPool - 1);
+            bench::keep(static_cast<double>(db.nearest(targets[k], 8, query)));
+        });
+
+        for (IK2dDamping damping : {IK2dDamping::Fixed, IK2dDamping::Adaptive}) {
+            for (size_t i = 0; i < kPool; ++i)
+                iters[i] = db.solve(arm, targets[i], ws, query, 4, 1e-6, 100, 1.0, 0.1, damping).iterations;
+            runner.run("ik_db_seed",
+                       {{"N", static_cast<long>(N)}, {"entries", entries},
+                        {"adaptive", damping == IK2dDamping::Adaptive ? 1L : 0L},
+                        {"median_iters", median(iters)}},
+                       [&] {
+                           k = (k + 1) & (kPool - 1);
+                           bench::keep(db.solve(arm, targets[k], ws, query, 4, 1e-6, 100, 1.0, 0.1, damping).residual);
+                       });
+        }
+    }
+
+    std::remove(path.c_str());
+    runner.finish();
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <cmath>
+#include <vector>
+
+#include "bench_util.hpp"
+
+#include "robot/ik_2d.hpp"
+#include "robot/ik_2d_step.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "robot/robot_arm_2d_n.hpp"
+
+using math::Vector2;
+using robot::IK2d;
+using robot::IK2dStep;
+using robot::IK2dStepBudget;
+using robot::IK2dStepState;
+using robot::IK2dWorkspace;
+using robot::RobotArm2dN;
+
+// Per-tick latency of servo-loop IK: p50/p99/p99.9/max over millions of
+// ticks tracking a moving target, for certifying worst-case timing.
+//   bench_ik_step [--json out.json]
+// Pin the process (taskset) and use an isolated core for stable tails.
+
+static constexpr size_t kTicks = 2000000;
+
+//target on a circle, one lap every 2000 ticks (2 s at 1 kHz)
+static Vector2 circle_target(size_t tick, double reach) {
+    const double a = 2.0 * M_PI * static_cast<double>(tick % 2000) / 2000.0;
+    return Vector2{0.5 * reach + 0.25 * reach * std::cos(a), 0.25 * reach * std::sin(a)};
+}
+
+template <std::size_t N>
+static void bench_ticks(bench::Runner& runner) {
+    std::array<double, N> lengths;
+    lengths.fill(1.0 / static_cast<double>(N));
+    RobotArm2dN<N> arm(lengths);
+    const double reach = arm.reach();
+
+    IK2dStep ik;
+    bench::Params params = {{"N", static_cast<long>(N)}};
+
+    IK2dStepState<N> s;
+    s.q.fill(0.2);
+    size_t tick = 0;
+    runner.latency("ik_step_1", params, [&] {
+        ik.step(arm, circle_target(tick++, reach), s);
+    }, kTicks);
+
+    //three updates per tick: tighter tracking at three times the cost
+    IK2dStepBudget three;
+    three.max_steps = 3;
+    runner.latency("ik_step_3", params, [&] {
+        ik.run(arm, circle_target(tick++, reach), s, three);
+    }, kTicks);
+
+    //iterate as long as 20 us allows
+    IK2dStepBudget timed;
+    timed.max_steps = 1000;
+    timed.time = std::chrono::microseconds(20);
+    IK2dStep ik_tight = ik;
+    ik_tight.tol = 0.0;
+    runner.latency("ik_step_budget_20us", params, [&] {
+        ik_tight.run(arm, circle_target(tick++, reach), s, timed);
+    }, kTicks / 20);
+
+    //the unbounded solver, warm-started every tick, for comparison
+    robot::RobotArm2d dyn = arm.to_dynamic();
+    IK2dWorkspace ws(dyn);
+    ws.q.assign(N, 0.2);
+    runner.latency("ik2d_solve_warm", params, [&] {
+        IK2d::solve(dyn, circle_target(tick++, reach), ws.q, ws, 1e-6, 100, 1.0, 0.1);
+    }, kTicks / 4);
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner("bench_ik_step", argc, argv);
+
+    //cost of the timing itself, included in every sample below
+    runner.latency("clock_overhead", {}, [] {}, kTicks);
+
+    bench_ticks<6>(runner);
+    bench_ticks<12>(runner);
+
+    runner.finish();
+    return 0;
+}
@@ -0,0 +1,464 @@
+#include <random>
+#include <vector>
+
+#include "bench_util.hpp"
+
+#include "math/matrix2.hpp"
+#include "math/matrix3.hpp"
+#include "math/se2.hpp"
+#include "math/se3.hpp"
+#include "math/so2.hpp"
+#include "math/se2_compact.hpp"
+#include "math/quaternion.hpp"
+#include "math/se3_quat.hpp"
+#include "math/transform_points.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "robot/jacobian_2d.hpp"
+#include "robot/ik_2d.hpp"
+#include "robot/fk_state_2d.hpp"
+#include "robot/robot_arm_3d.hpp"
+#include "robot/ik_3d.hpp"
+
+using namespace math;
+using robot::IK2d;
+using robot::IK2dWorkspace;
+using robot::IK3d;
+using robot::IK3dWorkspace;
+using robot::IncrementalFK2d;
+using robot::Jacobian2d;
+using robot::RobotArm2d;
+using robot::RobotArm3d;
+
+// Kinematics micro-benchmarks.
+//   bench_kinematics [--json out.json] [--min-time seconds]
+// Compare two commits by diffing their JSON output.
+
+static constexpr size_t kPool = 1024; //inputs cycled through per benchmark
+
+static RobotArm2d make_arm(size_t N) {
+    RobotArm2d arm{};
+    arm.link_lengths.assign(N, 1.0 / static_cast<double>(N));
+    return arm;
+}
+
+static std::vector<std::vector<double>> random_configs(size_t N, size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::vector<std::vector<double>> qs(count, std::vector<double>(N));
+    for (auto& q : qs)
+        for (auto& v : q) v = angle(rng);
+    return qs;
+}
+
+static void bench_math(bench::Runner& runner, std::mt19937& rng) {
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    std::vector<Matrix2> m2(kPool);
+    std::vector<Matrix3> m3(kPool);
+    std::vector<SE2> se2(kPool);
+    std::vector<SE2Compact> se2c(kPool);
+    std::vector<SE3> se3(kPool);
+    std::vector<SE3Quat> se3q(kPool);
+    for (size_t k = 0; k < kPool; ++k) {
+        m2[k] = Matrix2::rotation(angle(rng));
+        m3[k] = Matrix3::rotation_x(angle(rng)) * Matrix3::rotation_z(angle(rng));
+        se2[k] = SE2::from_angle_translation(angle(rng), Vector2{angle(rng), angle(rng)});
+        se2c[k] = SE2Compact(se2[k]);
+        se3[k] = SE3::from_rotation_translation(m3[k], Vector3{angle(rng), angle(rng), angle(rng)});
+        se3q[k] = SE3Quat(se3[k]);
+    }
+
+    size_t k = 0;
+    auto next = [&] { k = (k + 1) & (kPool - 1); return k; };
+
+    runner.run("matrix2_mul", {}, [&] {
+        size_t i = next();
+        bench::keep((m2[i] * m2[(i + 1) & (kPool - 1)]).m00);
+    });
+    runner.run("matrix3_mul", {}, [&] {
+        size_t i = next();
+        bench::keep((m3[i] * m3[(i + 1) & (kPool - 1)]).m00);
+    });
+    runner.run("se2_compose", {}, [&] {
+        size_t i = next();
+        bench::keep((se2[i] * se2[(i + 1) & (kPool - 1)]).t.x);
+    });
+    runner.run("se2_inverse", {}, [&] {
+        bench::keep(se2[next()].inverse().t.x);
+    });
+    runner.run("se2_compact_compose", {}, [&] {
+        size_t i = next();
+        bench::keep((se2c[i] * se2c[(i + 1) & (kPool - 1)]).t.x);
+    });
+    runner.run("se2_compact_inverse", {}, [&] {
+        bench::keep(se2c[next()].inverse().t.x);
+    });
+    runner.run("se3_compose", {}, [&] {
+        size_t i = next();
+        bench::keep((se3[i] * se3[(i + 1) & (kPool - 1)]).t.x);
+    });
+    runner.run("se3_inverse", {}, [&] {
+        bench::keep(se3[next()].inverse().t.x);
+    });
+    runner.run("se3_quat_compose", {}, [&] {
+        size_t i = next();
+        bench::keep((se3q[i] * se3q[(i + 1) & (kPool - 1)]).t.x);
+    });
+    runner.run("se3_quat_inverse", {}, [&] {
+        bench::keep(se3q[next()].inverse().t.x);
+    });
+    runner.run("se3_quat_transform_point", {}, [&] {
+        bench::keep((se3q[next()] * Vector3{1.0, 2.0, 3.0}).x);
+    });
+    runner.run("se3_transform_point", {}, [&] {
+        bench::keep((se3[next()] * Vector3{1.0, 2.0, 3.0}).x);
+    });
+
+    std::vector<Quaternion> quats(kPool);
+    std::vector<Matrix3> mats(kPool);
+    runner.run("quaternion_from_matrices", {{"n", static_cast<long>(kPool)}}, [&] {
+        math::from_matrices(m3.data(), quats.data(), kPool);
+        bench::keep(quats[0].w);
+    }, kPool);
+    runner.run("quaternion_to_matrices", {{"n", static_cast<long>(kPool)}}, [&] {
+        math::to_matrices(quats.data(), mats.data(), kPool);
+        bench::keep(mats[0].m00);
+    }, kPool);
+}
+
+static void bench_transform_points(bench::Runner& runner, std::mt19937& rng) {
+    std::uniform_real_distribution<double> u(-5.0, 5.0);
+
+    SE2 T2 = SE2::from_angle_translation(0.3, Vector2{1.0, -2.0});
+    SE3 T3 = SE3::from_rotation_translation(
+        Matrix3::rotation_z(0.3) * Matrix3::rotation_x(-0.7), Vector3{1.0, -2.0, 0.5});
+
+    //ns/op is per point
+    for (size_t n : {1000, 100000, 1000000}) {
+        bench::Params params = {{"n", static_cast<long>(n)}};
+
+        std::vector<Vector3> p3(n), o3(n);
+        for (auto& p : p3) p = Vector3{u(rng), u(rng), u(rng)};
+
+        runner.run("se3_points_aos_scalar", params, [&] {
+            for (size_t i = 0; i < n; ++i) o3[i] = T3 * p3[i];
+            bench::keep(o3[0].x);
+        }, n);
+        runner.run("se3_points_aos_bulk", params, [&] {
+            math::transform_points(T3, p3.data(), o3.data(), n);
+            bench::keep(o3[0].x);
+        }, n);
+
+        std::vector<double> x(n), y(n), z(n), ox(n), oy(n), oz(n);
+        for (size_t i = 0; i < n; ++i) { x[i] = u(rng); y[i] = u(rng); z[i] = u(rng); }
+
+        runner.run("se3_points_soa_bulk", params, [&] {
+            math::transform_points(T3, x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), n);
+            bench::keep(ox[0]);
+        }, n);
+
+        std::vector<Vector2> p2(n), o2(n);
+        for (auto& p : p2) p = Vector2{u(rng), u(rng)};
+
+        runner.run("se2_points_aos_scalar", params, [&] {
+            for (size_t i = 0; i < n; ++i) o2[i] = T2 * p2[i];
+            bench::keep(o2[0].x);
+        }, n);
+        runner.run("se2_points_aos_bulk", params, [&] {
+            math::transform_points(T2, p2.data(), o2.data(), n);
+            bench::keep(o2[0].x);
+        }, n);
+        runner.run("se2_points_soa_bulk", params, [&] {
+            math::transform_points(T2, x.data(), y.data(), ox.data(), oy.data(), n);
+            bench::keep(ox[0]);
+        }, n);
+    }
+}
+
+static void bench_arm(bench::Runner& runner, std::mt19937& rng) {
+    for (size_t N : {2, 4, 8, 16, 32}) {
+        RobotArm2d arm = make_arm(N);
+        auto qs = random_configs(N, kPool, rng);
+        bench::Params params = {{"N", static_cast<long>(N)}};
+
+        size_t k = 0;
+        auto next = [&]() -> const std::vector<double>& {
+            k = (k + 1) & (kPool - 1);
+            return qs[k];
+        };
+
+        runner.run("forward_kinematics", params, [&] {
+            bench::keep(arm.forward_kinematics(next()).t.x);
+        });
+        runner.run("joint_positions", params, [&] {
+            bench::keep(arm.joint_positions(next())[0].x);
+        });
+        runner.run("jacobian", params, [&] {
+            bench::keep(arm.jacobian(next())[0].x);
+        });
+
+        std::vector<Vector2> joints, J;
+        runner.run("kinematics_fused", params, [&] {
+            bench::keep(arm.kinematics(next(), joints, J).t.x);
+        });
+        runner.run("jacobian2d_compute", params, [&] {
+            bench::keep(Jacobian2d::compute(arm.link_lengths, next())[0][0]);
+        });
+    }
+}
+
+//the nested-loop Jacobian2d::compute this kernel replaced, kept as a baseline
+static double jacobian_nested(const std::vector<double>& L, const std::vector<double>& q, double* J) {
+    const size_t N = L.size();
+    std::vector<double> cumulative(N);
+    double sum = 0.0;
+    for (size_t i = 0; i < N; ++i)
+        cumulative[i] = sum += q[i];
+
+    for (size_t i = 0; i < N; ++i) {
+        double dx = 0.0, dy = 0.0;
+        for (size_t k = i; k < N; ++k) {
+            dx += -L[k] * std::sin(cumulative[k]);
+            dy += L[k] * std::cos(cumulative[k]);
+        }
+        J[i] = dx;
+        J[N + i] = dy;
+    }
+    return J[0];
+}
+
+static void bench_jacobian(bench::Runner& runner, std::mt19937& rng) {
+    for (size_t N : {8, 16, 32, 64, 128}) {
+        RobotArm2d arm = make_arm(N);
+        auto qs = random_configs(N, kPool, rng);
+        bench::Params params = {{"N", static_cast<long>(N)}};
+
+        size_t k = 0;
+        auto next = [&]() -> const std::vector<double>& {
+            k = (k + 1) & (kPool - 1);
+            return qs[k];
+        };
+
+        std::vector<double> J(2 * N);
+        runner.run("jacobian2d_nested", params, [&] {
+            bench::keep(jacobian_nested(arm.link_lengths, next(), J.data()));
+        });
+        runner.run("jacobian2d_suffix_buffer", params, [&] {
+            bench::keep(Jacobian2d::compute(arm.link_lengths, next(), J.data()).x);
+        });
+        runner.run("jacobian2d_suffix_nested_vectors", params, [&] {
+            bench::keep(Jacobian2d::compute(arm.link_lengths, next())[0][0]);
+        });
+
+        std::vector<Vector2> joints, cols;
+        runner.run("arm_kinematics_suffix", params, [&] {
+            bench::keep(arm.kinematics(next(), joints, cols).t.x);
+        });
+    }
+}
+
+static void bench_fk_batch(bench::Runner& runner, std::mt19937& rng) {
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    for (size_t N : {2, 8, 32}) {
+        for (size_t B : {64, 4096, 65536}) {
+            RobotArm2d arm = make_arm(N);
+            std::vector<double> q(N * B);
+            for (auto& v : q) v = angle(rng);
+            std::vector<double> x(B), y(B), theta(B);
+
+            runner.run("forward_kinematics_batch",
+                       {{"N", static_cast<long>(N)}, {"B", static_cast<long>(B)}},
+                       [&] {
+                arm.forward_kinematics_batch(q.data(), B, x.data(), y.data(), theta.data());
+                bench::keep(x[0]);
+            }, B);
+        }
+    }
+}
+
+static void bench_incremental_fk(bench::Runner& runner, std::mt19937& rng) {
+    std::uniform_real_distribution<double> delta(-0.01, 0.01);
+
+    for (size_t N : {20, 50}) {
+        RobotArm2d arm = make_arm(N);
+        std::vector<double> q(N, 0.05);
+        IncrementalFK2d fk(arm, q);
+
+        //perturb a distal, a middle and the base joint
+        for (size_t k : {N - 1, N / 2, size_t{0}}) {
+            bench::Params params = {{"N", static_cast<long>(N)}, {"k", static_cast<long>(k)}};
+
+            runner.run("fk_full_after_perturb", params, [&] {
+                q[k] += delta(rng);
+                bench::keep(arm.forward_kinematics(q).t.x);
+            });
+            runner.run("fk_incremental_set_joint", params, [&] {
+                fk.set_joint(k, fk.q()[k] + delta(rng));
+                bench::keep(fk.end_effector().x);
+            });
+            runner.run("fk_incremental_rotate_joint", params, [&] {
+                fk.rotate_joint(k, delta(rng));
+                bench::keep(fk.end_effector().x);
+            });
+        }
+    }
+}
+
+static RobotArm3d make_arm_3d(size_t N, std::mt19937& rng) {
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    std::vector<robot::DHParams> params(N);
+    for (auto& p : params)
+        p = {0.3 * u(rng), M_PI / 2 * std::round(u(rng)), 0.1 * u(rng), 0.0};
+    return RobotArm3d(params);
+}
+
+static void bench_arm_3d(bench::Runner& runner, std::mt19937& rng) {
+    //ns/op is per joint so the cost of one link step can be compared across N
+    for (size_t N : {6, 7, 12}) {
+        RobotArm3d arm = make_arm_3d(N, rng);
+        auto qs = random_configs(N, kPool, rng);
+        bench::Params params = {{"N", static_cast<long>(N)}};
+
+        size_t k = 0;
+        runner.run("arm3d_fk_per_joint", params, [&] {
+            k = (k + 1) & (kPool - 1);
+            bench::keep(arm.forward_kinematics(qs[k]).t.x);
+        }, N);
+
+        //generic SE3 composition of the four DH factors, for reference
+        runner.run("arm3d_fk_naive_per_joint", params, [&] {
+            k = (k + 1) & (kPool - 1);
+            SE3 T;
+            for (size_t i = 0; i < N; ++i) {
+                const auto& p = arm.links()[i];
+                T = T * SE3(Matrix3::rotation_z(p.theta + qs[k][i]), Vector3{0.0, 0.0, p.d})
+                      * SE3(Matrix3::rotation_x(p.alpha), Vector3{p.a, 0.0, 0.0});
+            }
+            bench::keep(T.t.x);
+        }, N);
+
+        std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+        for (size_t B : {64, 4096}) {
+            std::vector<double> qb(N * B);
+            for (auto& v : qb) v = angle(rng);
+            std::vector<SE3> poses(B);
+
+            runner.run("arm3d_fk_batch_per_joint",
+                       {{"N", static_cast<long>(N)}, {"B", static_cast<long>(B)}},
+                       [&] {
+                arm.forward_kinematics_batch(qb.data(), B, poses.data());
+                bench::keep(poses[0].t.x);
+            }, N * B);
+        }
+    }
+}
+
+static void bench_ik_3d(bench::Runner& runner, std::mt19937& rng) {
+    //UR5-like 6-DOF arm, full-pose targets
+    RobotArm3d arm{
+        {0.0,      M_PI / 2, 0.089159, 0.0},
+        {-0.425,   0.0,      0.0,      0.0},
+        {-0.39225, 0.0,      0.0,      0.0},
+        {0.0,      M_PI / 2, 0.10915,  0.0},
+        {0.0,     -M_PI / 2, 0.09465,  0.0},
+        {0.0,      0.0,      0.0823,   0.0}
+    };
+    auto goals = random_configs(6, kPool, rng);
+
+    std::vector<SE3> targets;
+    for (const auto& q : goals)
+        targets.push_back(arm.forward_kinematics(q));
+
+    size_t k = 0;
+    std::vector<SE3> frames;
+    std::vector<robot::JacobianColumn3d> J;
+    runner.run("arm3d_kinematics_fused", {{"N", 6L}}, [&] {
+        k = (k + 1) & (kPool - 1);
+        bench::keep(arm.kinematics(goals[k], frames, J).t.x);
+    });
+
+    //seed offset from the goal: 0.02 rad is a control-rate warm start
+    for (double offset : {0.02, 0.3}) {
+        std::uniform_real_distribution<double> noise(-offset, offset);
+        auto seeds = goals;
+        for (auto& q : seeds)
+            for (auto& v : q) v += noise(rng);
+
+        IK3dWorkspace ws(arm);
+        runner.run("ik3d_solve_workspace", {{"N", 6L}, {"seed_mrad", static_cast<long>(offset * 1000)}}, [&] {
+            k = (k + 1) & (kPool - 1);
+            bench::keep(IK3d::solve(arm, targets[k], seeds[k], ws).residual);
+        });
+    }
+}
+
+static void bench_ik(bench::Runner& runner, std::mt19937& rng) {
+    //2-link arms take the closed-form path; the rest iterate
+    for (size_t N : {2, 3, 6, 12}) {
+        RobotArm2d arm = make_arm(N);
+        auto seeds = random_configs(N, kPool, rng);
+        auto goals = random_configs(N, kPool, rng);
+
+        std::vector<Vector2> targets;
+        for (const auto& q : goals)
+            targets.push_back(arm.forward_kinematics(q) * Vector2{0.0, 0.0});
+
+        bench::Params params = {{"N", static_cast<long>(N)}};
+        size_t k = 0;
+
+        runner.run("ik_solve", params, [&] {
+            k = (k + 1) & (kPool - 1);
+            bench::keep(IK2d::solve(arm, targets[k], seeds[k], 1e-6, 100, 0.5)[0]);
+        });
+
+        IK2dWorkspace ws(arm);
+        runner.run("ik_solve_workspace", params, [&] {
+            k = (k + 1) & (kPool - 1);
+            bench::keep(IK2d::solve(arm, targets[k], seeds[k], ws, 1e-6, 100, 0.5).residual);
+        });
+
+        //fixed vs adaptive damping on the same targets; the mean iteration
+        //count and converged share are recorded as params. Both modes step
+        //along the same dp/dq Jacobian, so fixed_a10 against adaptive (same
+        //starting step and lambda) isolates the damping schedule.
+        struct Mode { const char* name; double alpha; robot::IK2dDamping damping; };
+        for (const Mode& mode : {Mode{"ik_damping_fixed_a01", 0.1, robot::IK2dDamping::Fixed},
+                                 Mode{"ik_damping_fixed_a05", 0.5, robot::IK2dDamping::Fixed},
+                                 Mode{"ik_damping_fixed_a10", 1.0, robot::IK2dDamping::Fixed},
+                                 Mode{"ik_damping_adaptive", 1.0, robot::IK2dDamping::Adaptive}}) {
+            long iters = 0, converged = 0;
+            for (size_t i = 0; i < kPool; ++i) {
+                auto r = IK2d::solve(arm, targets[i], seeds[i], ws, 1e-6, 200, mode.alpha, 0.1, mode.damping);
+                iters += r.iterations;
+                converged += r.converged() ? 1 : 0;
+            }
+
+            bench::Params mode_params = {{"N", static_cast<long>(N)},
+                                         {"mean_iters", iters / static_cast<long>(kPool)},
+                                         {"converged_pct", 100 * converged / static_cast<long>(kPool)}};
+            runner.run(mode.name, mode_params, [&] {
+                k = (k + 1) & (kPool - 1);
+                bench::keep(IK2d::solve(arm, targets[k], seeds[k], ws, 1e-6, 200,
+                                        mode.alpha, 0.1, mode.damping).residual);
+            });
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner("bench_kinematics", argc, argv);
+    std::mt19937 rng(1);
+
+    bench_math(runner, rng);
+    bench_transform_points(runner, rng);
+    bench_arm(runner, rng);
+    bench_jacobian(runner, rng);
+    bench_fk_batch(runner, rng);
+    bench_incremental_fk(runner, rng);
+    bench_arm_3d(runner, rng);
+    bench_ik(runner, rng);
+    bench_ik_3d(runner, rng);
+
+    runner.finish();
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_util.hpp"
+
+#include "robot/ik_2d.hpp"
+#include "robot/reachability_map_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+
+using math::Vector2;
+using robot::IK2d;
+using robot::IK2dWorkspace;
+using robot::ReachabilityMap2d;
+using robot::RobotArm2d;
+
+// Reachability map build, load and lookup, against finding out by running
+// IK2d::solve to max_iters on an unreachable target.
+//   bench_reachability_map [--json out.json] [--min-time seconds]
+
+static constexpr size_t kPool = 1024; //targets cycled through
+
+int main(int argc, char** argv) {
+    bench::Runner runner("bench_reachability_map", argc, argv);
+    std::mt19937 rng(1);
+
+    RobotArm2d arm{0.3, 0.3, 0.2, 0.2, 0.1, 0.1};
+    const long N = static_cast<long>(arm.link_lengths.size());
+    const uint64_t samples = uint64_t{1} << 22;
+
+    for (size_t threads : {1, 2, 4}) {
+        util::ThreadPool pool(threads);
+        runner.run("map_build",
+                   {{"N", N}, {"res_mm", 10L}, {"threads", static_cast<long>(threads)}},
+                   [&] {
+                       bench::keep(ReachabilityMap2d::build(arm, 0.01, samples, pool).max_manipulability());
+                   },
+                   samples);
+    }
+
+    util::ThreadPool pool(4);
+    ReachabilityMap2d built = ReachabilityMap2d::build(arm, 0.01, uint64_t{1} << 24, pool);
+    const std::string path = "bench_reachability_map.rmap";
+    built.save(path);
+
+    runner.run("map_load_mmap", {{"N", N}, {"cells_per_side", static_cast<long>(built.width())}}, [&] {
+        ReachabilityMap2d map;
+        ReachabilityMap2d::load(path, map);
+        bench::keep(map.max_manipulability());
+    });
+
+    ReachabilityMap2d map;
+    ReachabilityMap2d::load(path, map);
+
+    //half inside the 1.2 reach, half beyond it
+    std::uniform_real_distribution<double> radius(0.0, 2.4);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::vector<Vector2> targets(kPool);
+    for (auto& t : targets) {
+        const double r = radius(rng), a = angle(rng);
+        t = Vector2{r * std::cos(a), r * std::sin(a)};
+    }
+
+    size_t k = 0;
+    runner.run("map_reachable", {{"N", N}}, [&] {
+        k = (k + 1) & (kPool - 1);
+        bench::keep(map.reachable(targets[k]));
+    });
+    runner.run("map_manipulability", {{"N", N}}, [&] {
+        k = (k + 1) & (kPool - 1);
+        bench::keep(map.manipulability(targets[k]));
+    });
+
+    //what rejecting an unreachable target costs without the map
+    IK2dWorkspace ws(arm);
+    const std::vector<double> q0(arm.link_lengths.size(), 0.3);
+    runner.run("ik_unreachable_reject", {{"N", N}, {"max_iters", 100L}}, [&] {
+        k = (k + 1) & (kPool - 1);
+        const Vector2 far = targets[k] * (1.5 / std::max(targets[k].norm(), 1e-9));
+        bench::keep(IK2d::solve(arm, far, q0, ws, 1e-6, 100, 1.0, 0.1).residual);
+    });
+
+    std::remove(path.c_str());
+    runner.finish();
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "robot/robot_arm_2d.hpp"
+#include "robot/robot_arm_2d_n.hpp"
+#include "robot/ik_2d.hpp"
+#include "math/se2.hpp"
+
+using robot::IK2d;
+using robot::IK2dWorkspace;
+using robot::RobotArm2d;
+using robot::RobotArm2dN;
+using math::Vector2;
+
+// Fixed-DOF RobotArm2dN<N> vs dynamic RobotArm2d.
+// Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+
+static double g_checksum = 0.0;
+
+template <typename F>
+static double ns_per_op(size_t ops, F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(ops);
+}
+
+static void print_row(const char* what, size_t N, double dynamic_ns, double fixed_ns) {
+    std::cout << std::setw(10) << what
+              << std::setw(4) << N
+              << std::setw(14) << std::fixed << std::setprecision(1) << dynamic_ns
+              << std::setw(14) << fixed_ns
+              << std::setw(10) << std::setprecision(2) << dynamic_ns / fixed_ns << "\n";
+}
+
+template <std::size_t N>
+static void bench() {
+    constexpr size_t kConfigs = 1024;
+    constexpr size_t kReps = 200;
+    constexpr size_t kSolves = 20000;
+
+    std::mt19937 rng(static_cast<unsigned>(N));
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    std::array<double, N> L;
+    L.fill(1.0 / static_cast<double>(N));
+    RobotArm2dN<N> arm(L);
+    RobotArm2d dyn = arm.to_dynamic();
+
+    std::vector<std::array<double, N>> qs(kConfigs);
+    std::vector<std::vector<double>> qvs(kConfigs);
+    for (size_t k = 0; k < kConfigs; ++k) {
+        for (auto& v : qs[k]) v = angle(rng);
+        qvs[k].assign(qs[k].begin(), qs[k].end());
+    }
+
+    //forward kinematics
+    double dyn_fk = ns_per_op(kConfigs * kReps, [&] {
+        for (size_t r = 0; r < kReps; ++r)
+            for (const auto& q : qvs) g_checksum += dyn.forward_kinematics(q).t.x;
+    });
+    double fix_fk = ns_per_op(kConfigs * kReps, [&] {
+        for (size_t r = 0; r < kReps; ++r)
+            for (const auto& q : qs) g_checksum += arm.forward_kinematics(q).t.x;
+    });
+    print_row("fk", N, dyn_fk, fix_fk);
+
+    //Jacobian
+    double dyn_jac = ns_per_op(kConfigs * kReps, [&] {
+        for (size_t r = 0; r < kReps; ++r)
+            for (const auto& q : qvs) g_checksum += dyn.jacobian(q)[0].x;
+    });
+    double fix_jac = ns_per_op(kConfigs * kReps, [&] {
+        for (size_t r = 0; r < kReps; ++r)
+            for (const auto& q : qs) g_checksum += arm.jacobian(q)[0].x;
+    });
+    print_row("jacobian", N, dyn_jac, fix_jac);
+
+    //IK, dynamic arm with a reused workspace so only the solver is compared
+    Vector2 target = arm.forward_kinematics(qs[0]) * Vector2{0.0, 0.0};
+    IK2dWorkspace ws(dyn);
+    double dyn_ik = ns_per_op(kSolves, [&] {
+        for (size_t k = 0; k < kSolves; ++k)
+            g_checksum += IK2d::solve(dyn, target, qvs[k % kConfigs], ws, 1e-6, 100, 0.5).residual;
+    });
+    double fix_ik = ns_per_op(kSolves, [&] {
+        for (size_t k = 0; k < kSolves; ++k)
+            g_checksum += IK2d::solve(arm, target, qs[k % kConfigs], 1e-6, 100, 0.5).residual;
+    });
+    print_row("ik", N, dyn_ik, fix_ik);
+}
+
+int main() {
+    std::cout << std::setw(10) << "op"
+              << std::setw(4) << "N"
+              << std::setw(14) << "dynamic ns"
+              << std::setw(14) << "fixed ns"
+              << std::setw(10) << "speedup" << "\n";
+
+    bench<2>();
+    bench<3>();
+    bench<6>();
+    bench<7>();
+
+    //prevents the optimiser from discarding the timed loops
+    std::cout << "checksum " << g_checksum << "\n";
+    return 0;
+}
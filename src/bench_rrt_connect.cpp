@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "bench_util.hpp"
+
+#include "math/se2.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "robot/rrt_connect_2d.hpp"
+#include "util/thread_pool.hpp"
+
+using math::Vector2;
+using robot::RobotArm2d;
+using robot::RRTConnect2d;
+
+// Time to first solution of RRTConnect2d on cluttered scenes.
+//   bench_rrt_connect [--json out.json] [--min-time seconds]
+// Every call plans one of kInstances fixed start/goal pairs in turn; the
+// share of them solved and the mean tree size are recorded as params.
+
+static constexpr size_t kInstances = 64;
+
+static RobotArm2d make_arm(size_t N) {
+    RobotArm2d arm{};
+    arm.link_lengths.assign(N, 2.0 / static_cast<double>(N));
+    return arm;
+}
+
+//links as segments against circular obstacles
+struct CircleScene {
+    struct Circle { Vector2 c; double r; };
+
+    const RobotArm2d& arm;
+    std::vector<Circle> obstacles;
+
+    bool operator()(const double* q) const {
+        thread_local std::vector<double> qv;
+        thread_local std::vector<Vector2> joints;
+        qv.assign(q, q + arm.link_lengths.size());
+        arm.joint_positions(qv, joints);
+        Vector2 tip = arm.forward_kinematics(qv) * Vector2{0.0, 0.0};
+
+        for (size_t i = 0; i < joints.size(); ++i) {
+            Vector2 a = joints[i];
+            Vector2 b = (i + 1 < joints.size()) ? joints[i + 1] : tip;
+            Vector2 ab = b - a;
+            for (const auto& o : obstacles) {
+                double t = std::max(0.0, std::min(1.0, (o.c - a).dot(ab) / ab.dot(ab)));
+                if ((a + ab * t - o.c).norm() < o.r)
+                    return false;
+            }
+        }
+        return true;
+    }
+};
+
+static CircleScene make_scene(const RobotArm2d& arm, size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<double> pos(-1.8, 1.8);
+    CircleScene scene{arm, {}};
+    while (scene.obstacles.size() < count) {
+        Vector2 c{pos(rng), pos(rng)};
+        if (c.norm() > 0.6) //keep the base free
+            scene.obstacles.push_back({c, 0.2});
+    }
+    return scene;
+}
+
+struct Instance { std::vector<double> start, goal; };
+
+static std::vector<Instance> make_instances(size_t N, const CircleScene& scene, std::mt19937& rng) {
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    auto sample = [&] {
+        std::vector<double> q(N);
+        do {
+            for (auto& v : q) v = angle(rng);
+        } while (!scene(q.data()));
+        return q;
+    };
+
+    std::vector<Instance> out;
+    for (size_t i = 0; i < kInstances; ++i) {
+        Instance inst;
+        inst.start = sample();
+        inst.goal = sample();
+        out.push_back(std::move(inst));
+    }
+    return out;
+}
+
+static void bench_rrt(bench::Runner& runner, std::mt19937& rng) {
+    for (size_t N : {3, 6}) {
+        RobotArm2d arm = make_arm(N);
+        CircleScene scene = make_scene(arm, 8, rng);
+        auto instances = make_instances(N, scene, rng);
+
+        RRTConnect2d planner;
+        planner.max_iters = 5000;
+
+        //solved share and mean tree size over one pass of the instances
+        auto stats = [&](auto&& plan) {
+            long solved = 0, nodes = 0;
+            for (const auto& inst : instances) {
+                auto p = plan(inst);
+                solved += p.found ? 1 : 0;
+                nodes += static_cast<long>(p.nodes);
+            }
+            return bench::Params{{"N", static_cast<long>(N)},
+                                 {"solved_pct", 100 * solved / static_cast<long>(kInstances)},
+                                 {"mean_nodes", nodes / static_cast<long>(kInstances)}};
+        };
+
+        size_t k = 0;
+
+        auto serial = [&](const Instance& inst) {
+            return planner.solve(arm, inst.start, inst.goal, scene);
+        };
+        runner.run("rrt_connect_serial", stats(serial), [&] {
+            k = (k + 1) % kInstances;
+            bench::keep(serial(instances[k]).nodes);
+        });
+
+        for (size_t threads : {2, 4}) {
+            util::ThreadPool pool(threads);
+            auto parallel = [&](const Instance& inst) {
+                return planner.solve_parallel(arm, inst.start, inst.goal, scene, pool);
+            };
+            bench::Params params = stats(parallel);
+            params.push_back({"threads", static_cast<long>(threads)});
+            runner.run("rrt_connect_parallel", params, [&] {
+                k = (k + 1) % kInstances;
+                bench::keep(parallel(instances[k]).nodes);
+            });
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner("bench_rrt_connect", argc, argv);
+    std::mt19937 rng(1);
+
+    bench_rrt(runner, rng);
+
+    runner.finish();
+    return 0;
+}
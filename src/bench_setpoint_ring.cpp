@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "bench_util.hpp"
+
+#include "robot/setpoint_ring.hpp"
+
+using robot::SetpointRing;
+using robot::SetpointStream;
+
+// Planner-to-controller handoff of joint setpoints between two threads:
+// the lock-free SetpointRing vs the mutex-protected vector<vector<double>>
+// queue it replaces.
+//   bench_setpoint_ring [--json out.json] [--min-time seconds]
+// The producer runs on CPU 0 and the consumer on CPU 1 (CPU 0 as well on a
+// single-core machine, where every handoff costs a context switch).
+//   handoff_*        throughput, ns per setpoint over kBurst-setpoint bursts
+//   handoff_latency_* time from push to pop, one setpoint in flight at a time
+
+static constexpr size_t kBurst = 1 << 16;
+static constexpr size_t kSamples = 100000;
+
+//false if the affinity could not be set
+static bool pin(int cpu) {
+#ifdef __linux__
+    const unsigned n = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<unsigned>(cpu) % n, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+static int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//spin, then yield: the other side may share this core
+template <typename F>
+static void wait_until(F&& ready) {
+    for (int spins = 0; !ready(); ++spins)
+        if (spins >= SetpointStream::kSpins)
+            std::this_thread::yield();
+}
+
+//The glue SetpointRing replaces: the producer appends copies under a lock,
+//the consumer swaps the whole batch out under the same lock
+struct MutexQueue {
+    std::mutex mutex;
+    std::vector<std::vector<double>> pending;
+    bool closed = false;
+
+    void push(const double* q, size_t dof) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.emplace_back(q, q + dof);
+    }
+
+    //false once closed and drained
+    bool take(std::vector<std::vector<double>>& out) {
+        out.clear();
+        std::lock_guard<std::mutex> lock(mutex);
+        out.swap(pending);
+        return !out.empty() || !closed;
+    }
+};
+
+static void bench_throughput(bench::Runner& runner, size_t dof) {
+    for (size_t capacity : {64, 1024}) {
+        SetpointRing ring(dof, capacity);
+        runner.run("handoff_ring",
+                   {{"dof", static_cast<long>(dof)}, {"capacity", static_cast<long>(capacity)}},
+                   [&] {
+                       double sum = 0.0;
+                       std::thread consumer([&] {
+                           pin(1);
+                           double q[64];
+                           size_t n = 0;
+                           while (n < kBurst) {
+                               wait_until([&] { return ring.try_pop(q); });
+                               sum += q[0];
+                               ++n;
+                           }
+                       });
+                       SetpointStream stream(ring);
+                       std::vector<double> q(dof, 0.0);
+                       for (size_t i = 0; i < kBurst; ++i) {
+                           q[0] = static_cast<double>(i);
+                           stream.push(q.data());
+                       }
+                       consumer.join();
+                       bench::keep(sum);
+                   },
+                   kBurst);
+    }
+
+    runner.run("handoff_mutex_vector", {{"dof", static_cast<long>(dof)}},
+               [&] {
+                   MutexQueue queue;
+                   double sum = 0.0;
+                   std::thread consumer([&] {
+                       pin(1);
+                       std::vector<std::vector<double>> batch;
+                       while (queue.take(batch)) {
+                           for (const auto& q : batch) sum += q[0];
+                           if (batch.empty())
+                               std::this_thread::yield();
+                       }
+                   });
+                   std::vector<double> q(dof, 0.0);
+                   for (size_t i = 0; i < kBurst; ++i) {
+                       q[0] = static_cast<double>(i);
+                       queue.push(q.data(), dof);
+                   }
+                   {
+                       std::lock_guard<std::mutex> lock(queue.mutex);
+                       queue.closed = true;
+                   }
+                   consumer.join();
+                   bench::keep(sum);
+               },
+               kBurst);
+}
+
+//q[0] carries the push time; the consumer records pop time minus it
+static void bench_latency(bench::Runner& runner, size_t dof) {
+    std::vector<int64_t> ns(kSamples);
+    const bench::Params params = {{"dof", static_cast<long>(dof)}};
+
+    {
+        SetpointRing ring(dof, 64);
+        std::atomic<size_t> consumed{0};
+        std::thread consumer([&] {
+            pin(1);
+            double q[64];
+            for (size_t i = 0; i < kSamples; ++i) {
+                wait_until([&] { return ring.try_pop(q); });
+                ns[i] = now_ns() - static_cast<int64_t>(q[0]);
+                consumed.store(i + 1, std::memory_order_release);
+            }
+        });
+        std::vector<double> q(dof, 0.0);
+        for (size_t i = 0; i < kSamples; ++i) {
+            q[0] = static_cast<double>(now_ns());
+            ring.try_push(q.data());
+            wait_until([&] { return consumed.load(std::memory_order_acquire) == i + 1; });
+        }
+        consumer.join();
+        runner.record_latency("handoff_latency_ring", params, ns);
+    }
+
+    {
+        MutexQueue queue;
+        std::atomic<size_t> consumed{0};
+        std::thread consumer([&] {
+            pin(1);
+            std::vector<std::vector<double>> batch;
+            size_t i = 0;
+            while (i < kSamples) {
+                wait_until([&] { queue.take(batch); return !batch.empty(); });
+                for (const auto& q : batch) {
+                    ns[i] = now_ns() - static_cast<int64_t>(q[0]);
+                    consumed.store(++i, std::memory_order_release);
+                }
+            }
+        });
+        std::vector<double> q(dof, 0.0);
+        for (size_t i = 0; i < kSamples; ++i) {
+            q[0] = static_cast<double>(now_ns());
+            queue.push(q.data(), dof);
+            wait_until([&] { return consumed.load(std::memory_order_acquire) == i + 1; });
+        }
+        consumer.join();
+        runner.record_latency("handoff_latency_mutex_vector", params, ns);
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner("bench_setpoint_ring", argc, argv);
+    if (!pin(0))
+        std::cerr << "warning: could not pin threads, timings will be noisy\n";
+
+    for (size_t dof : {6, 32}) {
+        bench_throughput(runner, dof);
+        bench_latency(runner, dof);
+    }
+
+    runner.finish();
+    return 0;
+}
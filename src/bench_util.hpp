@@ -0,0 +1,257 @@
+#pragma once
+
+// Minimal benchmark harness shared by the bench_* executables.
+//
+// Include from exactly one translation unit per executable: it includes
+// alloc_counter.hpp, which replaces the global operator new/delete to count
+// heap allocations per operation.
+// Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "alloc_counter.hpp"
+
+namespace bench {
+
+inline std::atomic<size_t>& allocation_counter() {
+    return alloc_counter::count();
+}
+
+//sink that keeps benchmarked results observable to the optimiser
+inline void keep(double v) {
+    static volatile double sink = 0.0;
+    sink = sink + v;
+}
+
+using Params = std::vector<std::pair<std::string, long>>;
+
+struct Result {
+    std::string name;
+    Params params;
+    double ns_per_op = 0.0;
+    double ops_per_sec = 0.0;
+    double allocs_per_op = 0.0;
+    size_t iterations = 0;
+};
+
+//Per-call latency distribution of one benchmark
+struct LatencyResult {
+    std::string name;
+    Params params;
+    size_t samples = 0;
+    double mean_ns = 0.0;
+    double p50_ns = 0.0;
+    double p99_ns = 0.0;
+    double p999_ns = 0.0;
+    double max_ns = 0.0;
+    double allocs_per_op = 0.0;
+};
+
+class Runner {
+public:
+    explicit Runner(std::string suite, double min_time = 0.2)
+        : suite_(std::move(suite)), min_time_(min_time) {}
+
+    //Parses --json <path> and --min-time <seconds>
+    Runner(std::string suite, int argc, char** argv)
+        : suite_(std::move(suite)) {
+        for (int i = 1; i + 1 < argc; ++i) {
+            if (std::strcmp(argv[i], "--json") == 0)
+                json_path_ = argv[++i];
+            else if (std::strcmp(argv[i], "--min-time") == 0)
+                min_time_ = std::atof(argv[++i]);
+        }
+    }
+
+    //Times fn(), which performs ops_per_call operations, doubling the call
+    //count until a run lasts at least min_time seconds.
+    template <typename F>
+    const Result& run(const std::string& name, const Params& params, F&& fn,
+                      size_t ops_per_call = 1) {
+        using clock = std::chrono::steady_clock;
+
+        fn(); //warm-up: first-touch allocations and caches
+
+        size_t calls = 1;
+        for (;;) {
+            size_t allocs0 = allocation_counter().load(std::memory_order_relaxed);
+            auto t0 = clock::now();
+            for (size_t i = 0; i < calls; ++i)
+                fn();
+            auto t1 = clock::now();
+            size_t allocs1 = allocation_counter().load(std::memory_order_relaxed);
+
+            double secs = std::chrono::duration<double>(t1 - t0).count();
+            if (secs >= min_time_ || calls >= (size_t{1} << 40)) {
+                double ops = static_cast<double>(calls * ops_per_call);
+                Result r;
+                r.name = name;
+                r.params = params;
+                r.ns_per_op = secs * 1e9 / ops;
+                r.ops_per_sec = ops / secs;
+                r.allocs_per_op = static_cast<double>(allocs1 - allocs0) / ops;
+                r.iterations = calls * ops_per_call;
+                print(r);
+                results_.push_back(std::move(r));
+                return results_.back();
+            }
+            calls *= 2;
+        }
+    }
+
+    //Times each of `samples` calls of fn on its own and reports percentiles of
+    //the per-call latency, for worst-case rather than mean timing. Every
+    //sample includes one clock read; time an empty fn to see that overhead.
+    template <typename F>
+    const LatencyResult& latency(const std::string& name, const Params& params, F&& fn,
+                                 size_t samples) {
+        using clock = std::chrono::steady_clock;
+
+        std::vector<int64_t> ns(samples); //allocated before counting starts
+        for (size_t i = 0; i < std::min<size_t>(samples, 1000); ++i)
+            fn(); //warm-up
+
+        size_t allocs0 = allocation_counter().load(std::memory_order_relaxed);
+        clock::time_point t = clock::now();
+        for (size_t i = 0; i < samples; ++i) {
+            fn();
+            clock::time_point now = clock::now();
+            ns[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(now - t).count();
+            t = now;
+        }
+        size_t allocs1 = allocation_counter().load(std::memory_order_relaxed);
+
+        return record_latency(name, params, std::move(ns),
+                              static_cast<double>(allocs1 - allocs0) / static_cast<double>(samples));
+    }
+
+    //Reports latencies measured by the caller, e.g. across threads where a
+    //single clock pair around fn() cannot capture them. Sorts ns.
+    const LatencyResult& record_latency(const std::string& name, const Params& params,
+                                        std::vector<int64_t> ns, double allocs_per_op = 0.0) {
+        assert(!ns.empty());
+        const size_t samples = ns.size();
+
+        LatencyResult r;
+        r.name = name;
+        r.params = params;
+        r.samples = samples;
+        r.allocs_per_op = allocs_per_op;
+
+        double sum = 0.0;
+        for (int64_t v : ns) sum += static_cast<double>(v);
+        r.mean_ns = sum / static_cast<double>(samples);
+
+        std::sort(ns.begin(), ns.end());
+        auto pct = [&](double p) {
+            size_t i = static_cast<size_t>(p * static_cast<double>(samples - 1));
+            return static_cast<double>(ns[i]);
+        };
+        r.p50_ns = pct(0.5);
+        r.p99_ns = pct(0.99);
+        r.p999_ns = pct(0.999);
+        r.max_ns = static_cast<double>(ns.back());
+
+        print(r);
+        latencies_.push_back(std::move(r));
+        return latencies_.back();
+    }
+
+    const std::vector<Result>& results() const { return results_; }
+    const std::vector<LatencyResult>& latencies() const { return latencies_; }
+
+    //Writes every result as JSON when --json was given; entries are emitted
+    //in run order so files from two commits diff line by line
+    void finish() const {
+        if (json_path_.empty())
+            return;
+
+        std::ofstream out(json_path_);
+        out << "{\n  \"suite\": \"" << suite_ << "\",\n  \"results\": [\n";
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const Result& r = results_[i];
+            out << "    {\"name\": \"" << r.name << "\", \"params\": {";
+            for (size_t p = 0; p < r.params.size(); ++p) {
+                out << (p ? ", " : "") << "\"" << r.params[p].first << "\": " << r.params[p].second;
+            }
+            out << "}, \"ns_per_op\": " << r.ns_per_op
+                << ", \"ops_per_sec\": " << r.ops_per_sec
+                << ", \"allocs_per_op\": " << r.allocs_per_op
+                << ", \"iterations\": " << r.iterations << "}"
+                << (i + 1 < results_.size() ? "," : "") << "\n";
+        }
+        out << "  ]";
+        if (!latencies_.empty()) {
+            out << ",\n  \"latencies\": [\n";
+            for (size_t i = 0; i < latencies_.size(); ++i) {
+                const LatencyResult& r = latencies_[i];
+                out << "    {\"name\": \"" << r.name << "\", \"params\": {";
+                for (size_t p = 0; p < r.params.size(); ++p) {
+                    out << (p ? ", " : "") << "\"" << r.params[p].first << "\": " << r.params[p].second;
+                }
+                out << "}, \"samples\": " << r.samples
+                    << ", \"mean_ns\": " << r.mean_ns
+                    << ", \"p50_ns\": " << r.p50_ns
+                    << ", \"p99_ns\": " << r.p99_ns
+                    << ", \"p999_ns\": " << r.p999_ns
+                    << ", \"max_ns\": " << r.max_ns
+                    << ", \"allocs_per_op\": " << r.allocs_per_op << "}"
+                    << (i + 1 < latencies_.size() ? "," : "") << "\n";
+            }
+            out << "  ]";
+        }
+        out << "\n}\n";
+        std::cout << "wrote " << json_path_ << "\n";
+    }
+
+private:
+    static void print(const Result& r) {
+        std::string label = r.name;
+        for (const auto& p : r.params)
+            label += " " + p.first + "=" + std::to_string(p.second);
+
+        std::cout << std::left << std::setw(40) << label << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << r.ns_per_op << " ns/op"
+                  << std::setprecision(3) << std::scientific
+                  << std::setw(12) << r.ops_per_sec << " op/s"
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(8) << r.allocs_per_op << " allocs/op\n";
+    }
+
+    static void print(const LatencyResult& r) {
+        std::string label = r.name;
+        for (const auto& p : r.params)
+            label += " " + p.first + "=" + std::to_string(p.second);
+
+        std::cout << std::left << std::setw(40) << label << std::right
+                  << std::fixed << std::setprecision(0)
+                  << "  p50 " << std::setw(7) << r.p50_ns
+                  << "  p99 " << std::setw(7) << r.p99_ns
+                  << "  p99.9 " << std::setw(7) << r.p999_ns
+                  << "  max " << std::setw(9) << r.max_ns << " ns"
+                  << std::setprecision(2)
+                  << std::setw(8) << r.allocs_per_op << " allocs/op\n";
+    }
+
+    std::string suite_;
+    std::string json_path_;
+    double min_time_ = 0.2;
+    std::vector<Result> results_;
+    std::vector<LatencyResult> latencies_;
+};
+
+} //namespace bench
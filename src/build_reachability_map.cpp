@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "robot/reachability_map_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+
+using robot::ReachabilityMap2d;
+using robot::RobotArm2d;
+
+// Offline builder for ReachabilityMap2d files.
+//   build_reachability_map <out.rmap> <L1> [L2 ...] [--resolution m]
+//                          [--samples n] [--threads n] [--seed n]
+
+static int usage() {
+    std::cerr << "usage: build_reachability_map <out.rmap> <L1> [L2 ...] [--resolution m]\n"
+                 "                              [--samples n] [--threads n] [--seed n]\n";
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        return usage();
+
+    const std::string out = argv[1];
+    RobotArm2d arm{};
+    double resolution = 0.01;
+    uint64_t samples = uint64_t{1} << 24;
+    size_t threads = std::thread::hardware_concurrency();
+    uint64_t seed = 1;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--resolution") == 0 && i + 1 < argc)
+            resolution = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc)
+            samples = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (argv[i][0] == '-' && argv[i][1] == '-')
+            return usage();
+        else
+            arm.link_lengths.push_back(std::atof(argv[i]));
+    }
+    if (arm.link_lengths.empty() || !(resolution > 0.0) || samples == 0 || samples > UINT32_MAX)
+        return usage();
+
+    util::ThreadPool pool(threads);
+    auto t0 = std::chrono::steady_clock::now();
+    ReachabilityMap2d map = ReachabilityMap2d::build(arm, resolution, samples, pool, seed);
+    auto t1 = std::chrono::steady_clock::now();
+
+    size_t reached = 0;
+    const size_t cells = map.width() * map.height();
+    for (size_t i = 0; i < cells; ++i)
+        reached += map.hits_data()[i] > 0 ? 1 : 0;
+
+    std::cout << "grid " << map.width() << " x " << map.height()
+              << " at " << resolution << ", " << samples << " samples on "
+              << pool.size() << " threads in "
+              << std::chrono::duration<double>(t1 - t0).count() << " s\n"
+              << reached << " of " << cells << " cells reached, max manipulability "
+              << map.max_manipulability() << "\n";
+
+    if (!map.save(out)) {
+        std::cerr << "could not write " << out << "\n";
+        return 1;
+    }
+    std::cout << "wrote " << out << "\n";
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "robot/cartesian_path_2d.hpp"
+#include "robot/ik_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "math/se2.hpp"
+
+#include "alloc_counter.hpp"
+
+using robot::CartesianPathSummary2d;
+using robot::CartesianPlanner2d;
+using robot::CartesianPlannerWorkspace2d;
+using robot::CartesianSegment2d;
+using robot::CartesianWaypoint2d;
+using robot::RobotArm2d;
+using math::Vector2;
+
+static constexpr double EPS = 1e-6;
+
+Vector2 end_effector(const RobotArm2d& arm, const std::vector<double>& q) {
+    return arm.forward_kinematics(q) * Vector2{0.0, 0.0};
+}
+
+// ----------------------------------------------
+// Test 1: Line then arc, waypoints on the path at the requested spacing
+// ----------------------------------------------
+void test_line_and_arc() {
+    RobotArm2d arm{1.0, 0.8, 0.5};
+    CartesianPlannerWorkspace2d ws(arm);
+
+    CartesianSegment2d line = CartesianSegment2d::line(Vector2{1.5, 0.0}, Vector2{1.5, 0.6});
+    //quarter circle around the origin starting at the end of the line
+    double r = line.end.norm();
+    CartesianSegment2d arc = CartesianSegment2d::arc(Vector2{0.0, 0.0}, r, std::atan2(0.6, 1.5), M_PI / 4);
+
+    CartesianPlanner2d planner;
+    planner.resolution = 0.02;
+    planner.max_joint_step = 0.5;
+
+    std::vector<Vector2> points;
+    auto summary = planner.stream(arm, {line, arc}, {0.1, 0.1, 0.1}, ws, [&](const CartesianWaypoint2d& wp) {
+        assert(wp.index == points.size());
+        assert(wp.result.converged());
+        assert((end_effector(arm, wp.q) - wp.target).norm() < EPS);
+        points.push_back(wp.target);
+        return true;
+    });
+
+    assert(!summary.stopped);
+    assert(summary.failed == 0);
+    assert(summary.waypoints == points.size());
+    assert(points.size() == 1 + 30 + static_cast<size_t>(std::ceil(arc.length() / 0.02)));
+
+    for (size_t i = 1; i < points.size(); ++i)
+        assert((points[i] - points[i - 1]).norm() <= 0.02 + 1e-12);
+
+    //arc waypoints stay on the circle
+    for (size_t i = 31; i < points.size(); ++i)
+        assert(std::abs(points[i].norm() - r) < 1e-12);
+}
+
+// ----------------------------------------------
+// Test 2: Large joint steps are refined locally
+// ----------------------------------------------
+void test_local_refinement() {
+    RobotArm2d arm{1.0, 1.0};
+
+    //sweeping past the base makes the first joint turn quickly near the
+    //origin and slowly far from it
+    CartesianSegment2d line = CartesianSegment2d::line(Vector2{1.5, -0.2}, Vector2{-1.5, -0.2});
+
+    CartesianPlanner2d planner;
+    planner.resolution = 0.25;
+    planner.max_joint_step = 0.1;
+    planner.max_refine_depth = 8;
+
+    CartesianPathSummary2d summary;
+    auto path = planner.plan(arm, {line}, {-0.1, 0.5}, &summary);
+
+    assert(summary.refinements > 0);
+    assert(summary.jumps == 0);
+    assert(path.size() == summary.waypoints);
+
+    //more than the 13 coarse samples, but far fewer than sampling the whole
+    //line at the finest spacing (12 * 2^depth + 1): the refinement is local
+    assert(path.size() > 13);
+    assert(path.size() < (size_t{12} << planner.max_refine_depth) / 16);
+
+    for (size_t i = 1; i < path.size(); ++i) {
+        for (size_t j = 0; j < path.dof; ++j)
+            assert(std::abs(path.config(i)[j] - path.config(i - 1)[j]) <= planner.max_joint_step);
+    }
+}
+
+// ----------------------------------------------
+// Test 3: The callback can stop the stream early
+// ----------------------------------------------
+void test_early_stop() {
+    RobotArm2d arm{1.0, 0.8, 0.5};
+    CartesianPlannerWorkspace2d ws(arm);
+    CartesianPlanner2d planner;
+
+    size_t calls = 0;
+    auto summary = planner.stream(arm, {CartesianSegment2d::line(Vector2{1.5, 0.0}, Vector2{0.0, 1.5})},
+                                  {0.1, 0.1, 0.1}, ws, [&](const CartesianWaypoint2d&) {
+        return ++calls < 5;
+    });
+
+    assert(calls == 5);
+    assert(summary.waypoints == 5);
+    assert(summary.stopped);
+}
+
+// ----------------------------------------------
+// Test 4: Streaming reuses the workspace without allocating
+// ----------------------------------------------
+void test_stream_no_allocation() {
+    RobotArm2d arm{1.0, 1.0};
+    CartesianPlannerWorkspace2d ws(arm);
+    CartesianPlanner2d planner;
+    planner.resolution = 0.25;
+    planner.max_refine_depth = 8;
+
+    const std::vector<CartesianSegment2d> path = {
+        CartesianSegment2d::line(Vector2{1.5, -0.2}, Vector2{-1.5, -0.2})};
+    const std::vector<double> q0 = {-0.1, 0.5};
+    size_t waypoints = 0;
+    auto count = [&](const CartesianWaypoint2d&) { ++waypoints; return true; };
+
+    planner.stream(arm, path, q0, ws, count);
+    const size_t first = waypoints;
+
+    const size_t before = alloc_counter::allocations();
+    for (int i = 0; i < 5; ++i)
+        planner.stream(arm, path, q0, ws, count);
+    assert(alloc_counter::allocations() == before);
+    assert(waypoints == 6 * first);
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_line_and_arc();
+    test_local_refinement();
+    test_early_stop();
+    test_stream_no_allocation();
+
+    std::cout << "All CartesianPlanner2d tests passed\n";
+    return 0;
+}
@@ -0,0 +1,260 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "geometry/shapes_2d.hpp"
+#include "geometry/narrowphase_2d.hpp"
+#include "geometry/collision_scene_2d.hpp"
+#include "robot/arm_collision_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "robot/rrt_connect_2d.hpp"
+#include "util/thread_pool.hpp"
+
+using geometry::Box2d;
+using geometry::Capsule2d;
+using geometry::Circle2d;
+using geometry::CollisionScene2d;
+using geometry::CollisionWorkspace2d;
+using geometry::Polygon2d;
+using math::Vector2;
+using robot::ArmCollision2d;
+using robot::ArmCollisionWorkspace2d;
+using robot::RobotArm2d;
+
+// ----------------------------------------------
+// Helper: random obstacle scene of all primitive kinds
+// ----------------------------------------------
+CollisionScene2d random_scene(size_t count, double extent, std::mt19937& rng) {
+    std::uniform_real_distribution<double> pos(-extent, extent);
+    std::uniform_real_distribution<double> size(0.02, 0.12);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    CollisionScene2d scene;
+    for (size_t i = 0; i < count; ++i) {
+        Vector2 c{pos(rng), pos(rng)};
+        switch (i % 4) {
+        case 0: scene.add(Circle2d{c, size(rng)}); break;
+        case 1: scene.add(Box2d{c, {size(rng), size(rng)}, angle(rng)}); break;
+        case 2: {
+            double r = size(rng), a = angle(rng);
+            scene.add(Polygon2d({c + Vector2{r * std::cos(a), r * std::sin(a)},
+                                 c + Vector2{r * std::cos(a + 2.0), r * std::sin(a + 2.0)},
+                                 c + Vector2{r * std::cos(a + 4.0), r * std::sin(a + 4.0)}}));
+            break;
+        }
+        default: scene.add(Capsule2d{c, c + Vector2{size(rng), size(rng)}, 0.5 * size(rng)}); break;
+        }
+    }
+    scene.build();
+    return scene;
+}
+
+// ----------------------------------------------
+// Test 1: segment and point primitives
+// ----------------------------------------------
+void test_segment_primitives() {
+    using geometry::point_segment_distance2;
+    using geometry::segments_intersect;
+    using geometry::segment_segment_distance2;
+
+    Vector2 a{0.0, 0.0}, b{2.0, 0.0};
+
+    assert(std::abs(point_segment_distance2({1.0, 1.0}, a, b) - 1.0) < 1e-12);
+    assert(std::abs(point_segment_distance2({3.0, 0.0}, a, b) - 1.0) < 1e-12);
+    assert(std::abs(point_segment_distance2({1.0, 0.0}, a, a) - 1.0) < 1e-12); //degenerate
+
+    assert(segments_intersect(a, b, {1.0, -1.0}, {1.0, 1.0}));
+    assert(segments_intersect(a, b, {2.0, 0.0}, {3.0, 1.0}));  //shared end point
+    assert(segments_intersect(a, b, {1.0, 0.0}, {3.0, 0.0}));  //collinear overlap
+    assert(!segments_intersect(a, b, {2.5, 0.0}, {3.0, 0.0})); //collinear, apart
+    assert(!segments_intersect(a, b, {1.0, 0.5}, {1.0, 1.0}));
+
+    assert(std::abs(segment_segment_distance2(a, b, {1.0, 0.5}, {1.0, 1.0}) - 0.25) < 1e-12);
+    assert(segment_segment_distance2(a, b, {1.0, -1.0}, {1.0, 1.0}) == 0.0);
+}
+
+// ----------------------------------------------
+// Test 2: capsule against every primitive
+// ----------------------------------------------
+void test_capsule_narrowphase() {
+    Capsule2d cap{{0.0, 0.0}, {2.0, 0.0}, 0.1};
+
+    assert(geometry::intersects(cap, Circle2d{{1.0, 0.35}, 0.3}));
+    assert(!geometry::intersects(cap, Circle2d{{1.0, 0.45}, 0.3}));
+    assert(std::abs(geometry::distance(cap, Circle2d{{1.0, 0.45}, 0.3}) - 0.05) < 1e-12);
+
+    //a box rotated by 45 degrees whose lower corner is 0.15 above the segment
+    Box2d box{{1.0, 0.15 + std::sqrt(0.5)}, {0.5, 0.5}, M_PI / 4.0};
+    assert(!geometry::intersects(cap, box));
+    assert(std::abs(geometry::distance(cap, box) - 0.05) < 1e-9);
+    box.center.y -= 0.1;
+    assert(geometry::intersects(cap, box));
+
+    //segment entirely inside a polygon
+    Polygon2d big({{-1.0, -1.0}, {3.0, -1.0}, {3.0, 1.0}, {-1.0, 1.0}});
+    assert(geometry::intersects(cap, big));
+    assert(geometry::distance(cap, big) == 0.0);
+
+    //clockwise input is reordered
+    Polygon2d tri({{1.0, 0.5}, {0.5, 1.5}, {1.5, 1.5}});
+    assert(geometry::cross(tri.vertices[1] - tri.vertices[0], tri.vertices[2] - tri.vertices[0]) > 0.0);
+    assert(std::abs(geometry::distance(cap, tri) - 0.4) < 1e-12);
+
+    assert(geometry::intersects(cap, Capsule2d{{1.0, 0.5}, {1.0, 0.3}, 0.2}));
+    assert(!geometry::intersects(cap, Capsule2d{{1.0, 0.5}, {1.0, 0.3}, 0.15}));
+}
+
+// ----------------------------------------------
+// Test 3: grid broadphase agrees with brute force
+// ----------------------------------------------
+void test_broadphase_matches_brute_force() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> pos(-2.5, 2.5);
+    std::uniform_real_distribution<double> len(-0.5, 0.5);
+
+    CollisionScene2d scene = random_scene(400, 2.0, rng);
+    assert(scene.built());
+
+    CollisionWorkspace2d ws;
+    size_t hits = 0;
+    for (int k = 0; k < 5000; ++k) {
+        Vector2 a{pos(rng), pos(rng)};
+        Capsule2d cap{a, a + Vector2{len(rng), len(rng)}, 0.03};
+        bool hit = scene.intersects(cap, ws);
+        assert(hit == scene.intersects_brute_force(cap));
+        hits += hit ? 1 : 0;
+    }
+    //both outcomes are exercised
+    assert(hits > 500 && hits < 4500);
+
+    //explicit small cells: obstacles span many cells, still tested once each
+    scene.build(0.01);
+    for (int k = 0; k < 500; ++k) {
+        Vector2 a{pos(rng), pos(rng)};
+        Capsule2d cap{a, a + Vector2{len(rng), len(rng)}, 0.03};
+        assert(scene.intersects(cap, ws) == scene.intersects_brute_force(cap));
+    }
+
+    CollisionScene2d empty;
+    empty.build();
+    assert(!empty.intersects(Capsule2d{{0.0, 0.0}, {1.0, 0.0}, 1.0}, ws));
+}
+
+// ----------------------------------------------
+// Test 4: arm links against the scene, single and batched
+// ----------------------------------------------
+void test_arm_collision() {
+    RobotArm2d arm{0.5, 0.5};
+
+    CollisionScene2d scene;
+    scene.add(Box2d{{1.5, 0.0}, {0.2, 0.2}});
+    scene.build();
+
+    ArmCollision2d checker(arm, scene, 0.05);
+    ArmCollisionWorkspace2d ws;
+
+    //stretched along +x the tip at x = 1.0 stays clear of the box at x >= 1.3
+    assert(!checker.in_collision({0.0, 0.0}, ws));
+
+    //link_points ends at the end effector
+    std::vector<Vector2> points;
+    arm.link_points({0.3, -0.2}, points);
+    assert(points.size() == 3);
+    Vector2 tip = arm.forward_kinematics({0.3, -0.2}) * Vector2{0.0, 0.0};
+    assert((points[2] - tip).norm() < 1e-12);
+
+    RobotArm2d long_arm{0.8, 0.8};
+    ArmCollision2d long_checker(long_arm, scene, 0.05);
+    assert(long_checker.in_collision({0.0, 0.0}, ws));
+    assert(!long_checker.in_collision({M_PI / 2.0, 0.0}, ws));
+
+    //batch results match one-by-one checks
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    RobotArm2d arm6{0.4, 0.4, 0.3, 0.3, 0.2, 0.2};
+    CollisionScene2d clutter = random_scene(200, 2.0, rng);
+    ArmCollision2d checker6(arm6, clutter, 0.02);
+
+    const size_t count = 1000;
+    std::vector<double> qs(count * 6);
+    for (auto& v : qs) v = angle(rng);
+
+    std::vector<uint8_t> free(count, 2);
+    util::ThreadPool pool(3);
+    checker6.check_batch(qs.data(), count, free.data(), pool);
+
+    size_t n_free = 0;
+    for (size_t b = 0; b < count; ++b) {
+        bool ok = checker6(qs.data() + b * 6);
+        assert(free[b] == (ok ? 1 : 0));
+        n_free += ok ? 1 : 0;
+    }
+    assert(n_free > 0 && n_free < count);
+}
+
+// ----------------------------------------------
+// Test 5: the checker plugs into RRTConnect2d
+// ----------------------------------------------
+void test_planner_integration() {
+    RobotArm2d arm{0.6, 0.5, 0.4};
+
+    CollisionScene2d scene;
+    scene.add(Circle2d{{0.9, 0.6}, 0.2});
+    scene.add(Box2d{{-0.6, 0.8}, {0.15, 0.15}, 0.3});
+    scene.add(Polygon2d({{0.2, -1.2}, {0.6, -1.0}, {0.3, -0.8}}));
+    scene.build();
+
+    ArmCollision2d checker(arm, scene, 0.03);
+    std::vector<double> start{0.0, 0.2, 0.2}, goal{2.5, -0.4, 0.3};
+    assert(checker(start.data()) && checker(goal.data()));
+
+    robot::RRTConnect2d planner;
+    robot::RRTPath2d path = planner.solve(arm, start, goal, checker);
+    assert(path.found);
+    for (size_t k = 0; k < path.size(); ++k)
+        assert(checker(path.config(k)));
+}
+
+// ----------------------------------------------
+// Test 6: queries and cells far beyond the scene bounds
+// ----------------------------------------------
+void test_far_outside_bounds() {
+    std::mt19937 rng(6);
+    CollisionScene2d scene = random_scene(100, 1.0, rng);
+    CollisionWorkspace2d ws;
+
+    const std::vector<Capsule2d> caps = {
+        //entirely outside
+        Capsule2d{{1e12, -1e12}, {1e12 + 1.0, -1e12}, 0.1},
+        //from inside the scene to far beyond it on every side
+        Capsule2d{{0.0, 0.0}, {1e15, 0.0}, 0.05},
+        Capsule2d{{0.0, 0.0}, {-1e15, -1e15}, 0.05},
+        Capsule2d{{0.3, -0.2}, {0.3, 1e300}, 0.05},
+        Capsule2d{{-0.4, 0.1}, {2.0, 0.1}, 1e12},
+    };
+    for (double cell : {0.0, 1e-12}) {
+        scene.build(cell);
+        for (const Capsule2d& cap : caps)
+            assert(scene.intersects(cap, ws) == scene.intersects_brute_force(cap));
+    }
+    assert(!scene.intersects(caps[0], ws));
+    assert(scene.intersects(caps[4], ws));
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_segment_primitives();
+    test_capsule_narrowphase();
+    test_broadphase_matches_brute_force();
+    test_arm_collision();
+    test_planner_integration();
+    test_far_outside_bounds();
+
+    std::cout << "All collision tests passed\n";
+    return 0;
+}
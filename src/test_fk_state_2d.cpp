@@ -0,0 +1,120 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "robot/fk_state_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "math/se2.hpp"
+
+using robot::IncrementalFK2d;
+using robot::RobotArm2d;
+using math::Vector2;
+
+static constexpr double EPS = 1e-9;
+
+// ----------------------------------------------
+// Helper: compare cached state against a full FK
+// ----------------------------------------------
+void assert_matches_full_fk(const RobotArm2d& arm, const IncrementalFK2d& fk) {
+    auto T = arm.forward_kinematics(fk.q());
+    auto joints = arm.joint_positions(fk.q());
+
+    assert(std::abs(fk.end_effector().x - T.t.x) < EPS);
+    assert(std::abs(fk.end_effector().y - T.t.y) < EPS);
+
+    auto P = fk.pose();
+    assert(std::abs(P.R.m00 - T.R.m00) < EPS);
+    assert(std::abs(P.R.m10 - T.R.m10) < EPS);
+
+    for (size_t i = 0; i < joints.size(); ++i) {
+        assert(std::abs(fk.joint_positions()[i].x - joints[i].x) < EPS);
+        assert(std::abs(fk.joint_positions()[i].y - joints[i].y) < EPS);
+    }
+}
+
+RobotArm2d make_arm(size_t N) {
+    RobotArm2d arm{};
+    for (size_t i = 0; i < N; ++i)
+        arm.link_lengths.push_back(1.0 / static_cast<double>(i + 1));
+    return arm;
+}
+
+// ----------------------------------------------
+// Test 1: Initial state matches full FK
+// ----------------------------------------------
+void test_initial_state() {
+    RobotArm2d arm{1.0, 1.0, 1.0};
+    IncrementalFK2d fk(arm, {M_PI/2, -M_PI/2, 0.0});
+
+    assert(std::abs(fk.end_effector().x - 0.0) < 1e-6);
+    assert(std::abs(fk.end_effector().y - 3.0) < 1e-6);
+    assert_matches_full_fk(arm, fk);
+}
+
+// ----------------------------------------------
+// Test 2: Single-joint updates track full FK
+// ----------------------------------------------
+void test_set_joint() {
+    RobotArm2d arm = make_arm(30);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_int_distribution<size_t> joint(0, 29);
+
+    std::vector<double> q(30);
+    for (auto& v : q) v = 0.1 * angle(rng);
+    IncrementalFK2d fk(arm, q);
+
+    for (int step = 0; step < 200; ++step) {
+        fk.set_joint(joint(rng), 0.1 * angle(rng));
+        assert_matches_full_fk(arm, fk);
+    }
+}
+
+// ----------------------------------------------
+// Test 3: Rigid subchain rotations track full FK
+// ----------------------------------------------
+void test_rotate_joint() {
+    RobotArm2d arm = make_arm(40);
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<double> delta(-0.2, 0.2);
+    std::uniform_int_distribution<size_t> joint(0, 39);
+
+    IncrementalFK2d fk(arm, std::vector<double>(40, 0.05));
+
+    //long enough to pass through several periodic refreshes
+    for (int step = 0; step < 1000; ++step) {
+        fk.rotate_joint(joint(rng), delta(rng));
+        if (step % 50 == 0)
+            assert_matches_full_fk(arm, fk);
+    }
+    assert_matches_full_fk(arm, fk);
+}
+
+// ----------------------------------------------
+// Test 4: Rotating the last joint only turns the last link
+// ----------------------------------------------
+void test_rotate_last_joint() {
+    RobotArm2d arm{1.0, 1.0};
+    IncrementalFK2d fk(arm, {0.0, 0.0});
+
+    fk.rotate_joint(1, M_PI/2);
+
+    assert(std::abs(fk.end_effector().x - 1.0) < EPS);
+    assert(std::abs(fk.end_effector().y - 1.0) < EPS);
+    assert_matches_full_fk(arm, fk);
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_initial_state();
+    test_set_joint();
+    test_rotate_joint();
+    test_rotate_last_joint();
+
+    std::cout << "All IncrementalFK2d tests passed\n";
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <random>
 #include <vector>
 
 #include "robot/ik_2d.hpp"
@@ -8,6 +9,8 @@
 #include "math/se2.hpp"
 
 using robot::IK2d;
+using robot::IK2dDamping;
+using robot::IK2dWorkspace;
 using robot::RobotArm2d;
 using math::Vector2;
 
@@ -92,6 +95,56 @@ void test_ik_unreachable() {
     assert(std::abs(dist - 2.0) < EPS);
 }
 
+// ----------------------------------------------------
+// Test 5: Adaptive damping converges in fewer iterations
+// ----------------------------------------------------
+void test_ik_adaptive_damping() {
+    RobotArm2d arm{0.6, 0.5, 0.4, 0.3, 0.2};
+    IK2dWorkspace ws(arm);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    //same dp/dq Jacobian, step length and starting damping in both modes:
+    //only the damping schedule differs
+    int fixed_iters = 0, adaptive_iters = 0;
+    for (int t = 0; t < 64; ++t) {
+        std::vector<double> goal(5), q0(5);
+        for (auto& v : goal) v = angle(rng);
+        for (auto& v : q0) v = angle(rng);
+        Vector2 target = end_effector(arm, goal);
+
+        auto rf = IK2d::solve(arm, target, q0, ws, 1e-6, 500, 1.0, 0.1);
+        assert(rf.converged());
+        fixed_iters += rf.iterations;
+
+        auto ra = IK2d::solve(arm, target, q0, ws, 1e-6, 500, 1.0, 0.1, IK2dDamping::Adaptive);
+        assert(ra.converged());
+        assert((end_effector(arm, ws.q) - target).norm() < 1e-6);
+        adaptive_iters += ra.iterations;
+    }
+
+    assert(4 * adaptive_iters < 3 * fixed_iters);
+}
+
+// ----------------------------------------------------
+// Test 6: Adaptive damping never increases the error
+// ----------------------------------------------------
+void test_ik_adaptive_unreachable() {
+    RobotArm2d arm{1.0, 1.0, 1.0};
+    IK2dWorkspace ws(arm);
+
+    Vector2 target{0.0, 4.0}; //beyond max reach of 3.0
+    std::vector<double> q0 = {0.3, 0.2, 0.1};
+    double initial = (end_effector(arm, q0) - target).norm();
+
+    auto r = IK2d::solve_iterative(arm, target, q0, ws, 1e-6, 100, 1.0, 0.1, IK2dDamping::Adaptive);
+
+    assert(!r.converged());
+    assert(r.residual <= initial);
+    assert(std::abs(r.residual - 1.0) < EPS); //stretched toward the target
+}
+
 // --------------------------------
 // Main
 // --------------------------------
@@ -100,6 +153,8 @@ int main() {
     test_ik_diagonal();
     test_ik_far_initial_guess();
     test_ik_unreachable();
+    test_ik_adaptive_damping();
+    test_ik_adaptive_unreachable();
 
     std::cout << "All IK2d tests passed\n";
     return 0;
@@ -0,0 +1,161 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "robot/ik_2d_analytic.hpp"
+#include "robot/ik_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "math/se2.hpp"
+
+using robot::IK2d;
+using robot::IK2dAnalytic;
+using robot::IK2dBranches;
+using robot::IK2dWorkspace;
+using robot::RobotArm2d;
+using math::Vector2;
+
+static constexpr double EPS = 1e-9;
+
+// ----------------------------------------------
+// Helper: end-effector position of a branch
+// ----------------------------------------------
+Vector2 branch_end_effector(const RobotArm2d& arm, const IK2dBranches& br, size_t k) {
+    std::vector<double> q(br.q[k].begin(), br.q[k].begin() + br.dof);
+    return arm.forward_kinematics(q) * Vector2{0.0, 0.0};
+}
+
+// ----------------------------------------------
+// Test 1: 2R returns both elbow branches
+// ----------------------------------------------
+void test_2r_two_branches() {
+    RobotArm2d arm{1.0, 0.7};
+    Vector2 target{0.9, 0.8};
+
+    auto br = IK2dAnalytic::solve(arm, target);
+
+    assert(br.exact);
+    assert(br.count == 2);
+    for (size_t k = 0; k < br.count; ++k) {
+        Vector2 p = branch_end_effector(arm, br, k);
+        assert(std::abs(p.x - target.x) < EPS);
+        assert(std::abs(p.y - target.y) < EPS);
+    }
+
+    //elbow angle (q1 + q2 in this convention) has opposite signs
+    double elbow0 = br.q[0][0] + br.q[0][1];
+    double elbow1 = br.q[1][0] + br.q[1][1];
+    assert(elbow0 > 0.0 && elbow1 < 0.0);
+}
+
+// ----------------------------------------------
+// Test 2: 2R out of reach stretches toward the target
+// ----------------------------------------------
+void test_2r_unreachable() {
+    RobotArm2d arm{1.0, 1.0};
+    Vector2 target{0.0, 3.0};
+
+    auto br = IK2dAnalytic::solve(arm, target);
+
+    assert(!br.exact);
+    assert(br.count == 1);
+
+    Vector2 p = branch_end_effector(arm, br, 0);
+    assert(std::abs(p.x - 0.0) < EPS);
+    assert(std::abs(p.y - 2.0) < EPS);
+}
+
+// ----------------------------------------------
+// Test 3: 3R branches honour the wrist angle
+// ----------------------------------------------
+void test_3r_wrist_angle() {
+    RobotArm2d arm{1.0, 0.8, 0.3};
+    Vector2 target{1.0, 0.9};
+    double psi = 0.4;
+
+    auto br = IK2dAnalytic::solve(arm, target, psi);
+
+    assert(br.exact);
+    assert(br.count == 2);
+    for (size_t k = 0; k < br.count; ++k) {
+        std::vector<double> q(br.q[k].begin(), br.q[k].end());
+        auto T = arm.forward_kinematics(q);
+
+        assert(std::abs(T.t.x - target.x) < EPS);
+        assert(std::abs(T.t.y - target.y) < EPS);
+        assert(std::abs(T.R.m00 - std::cos(psi)) < EPS);
+        assert(std::abs(T.R.m10 - std::sin(psi)) < EPS);
+    }
+}
+
+// ----------------------------------------------
+// Test 4: IK2d dispatches 2-link arms to the closest branch
+// ----------------------------------------------
+void test_dispatch_closest_branch() {
+    RobotArm2d arm{1.0, 1.0};
+    IK2dWorkspace ws(arm);
+    Vector2 target{1.0, 1.0};
+
+    //seeds on either side of the straight arm pick different branches
+    std::vector<double> up = {0.2, 1.0};
+    std::vector<double> down = {1.2, -1.5};
+
+    auto r_up = IK2d::solve(arm, target, up, ws);
+    std::vector<double> q_up = ws.q;
+    assert(r_up.converged());
+    assert(r_up.iterations == 0);
+    assert(r_up.residual < EPS);
+
+    auto r_down = IK2d::solve(arm, target, down, ws);
+    std::vector<double> q_down = ws.q;
+    assert(r_down.converged());
+    assert(r_down.iterations == 0);
+    assert(r_down.residual < EPS);
+
+    assert(q_up[0] + q_up[1] > 0.0);
+    assert(q_down[0] + q_down[1] < 0.0);
+
+    //joints are kept within pi of the seed
+    std::vector<double> far = {0.2 + 4.0 * M_PI, 1.0 - 2.0 * M_PI};
+    IK2d::solve(arm, target, far, ws);
+    const auto& q_far = ws.q;
+    assert(std::abs(q_far[0] - far[0]) <= M_PI);
+    assert(std::abs(q_far[1] - far[1]) <= M_PI);
+}
+
+// ----------------------------------------------
+// Test 5: 3-link arm falls back when the wrist cannot reach
+// ----------------------------------------------
+void test_dispatch_3r_fallback() {
+    RobotArm2d arm{1.0, 0.8, 0.5};
+    IK2dWorkspace ws(arm);
+    Vector2 target{2.1, 0.0};
+
+    //last link pointing backwards puts the wrist out of reach
+    std::vector<double> q0 = {0.0, 0.0, M_PI};
+    auto r0 = IK2d::solve(arm, target, q0, ws, 1e-6, 200, 0.5);
+    assert(r0.converged());
+    assert(r0.iterations > 0);
+    assert(r0.residual < 1e-6);
+
+    //last link already aligned: closed form, no iterations
+    std::vector<double> q1 = {0.1, -0.1, 0.0};
+    auto r1 = IK2d::solve(arm, target, q1, ws, 1e-6, 200, 0.5);
+    assert(r1.converged());
+    assert(r1.iterations == 0);
+    assert(r1.residual < EPS);
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_2r_two_branches();
+    test_2r_unreachable();
+    test_3r_wrist_angle();
+    test_dispatch_closest_branch();
+    test_dispatch_3r_fallback();
+
+    std::cout << "All IK2dAnalytic tests passed\n";
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "robot/ik_2d_multi_start.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+#include "math/se2.hpp"
+
+using robot::IK2dMultiStart;
+using robot::RobotArm2d;
+using util::ThreadPool;
+using math::Vector2;
+
+// ----------------------------------------------
+// Helper: compute end-effector position
+// ----------------------------------------------
+Vector2 end_effector(const RobotArm2d& arm, const std::vector<double>& q) {
+    auto T = arm.forward_kinematics(q);
+    return T * Vector2{0.0, 0.0};
+}
+
+// ----------------------------------------------
+// Test 1: Random seeds across threads reach the target
+// ----------------------------------------------
+void test_multi_start_converges() {
+    RobotArm2d arm{1.0, 0.8, 0.5};
+    ThreadPool pool(4);
+
+    Vector2 target{1.1, 1.0};
+    std::vector<double> q0 = {0.0, 0.0, 0.0};
+
+    auto result = IK2dMultiStart::solve(arm, target, q0, 16, pool, 7, 1e-6, 200, 0.5);
+
+    assert(result.converged);
+    assert(result.seeds.size() == 16);
+    assert(result.seeds[result.best_seed].converged());
+    assert(result.q.size() == 3);
+
+    Vector2 p = end_effector(arm, result.q);
+    assert(std::abs(p.x - target.x) < 1e-5);
+    assert(std::abs(p.y - target.y) < 1e-5);
+}
+
+// ----------------------------------------------
+// Test 2: First success cancels the remaining seeds
+// ----------------------------------------------
+void test_first_success_cancels() {
+    RobotArm2d arm{1.0, 1.0};
+    ThreadPool pool(1); //serial, so seed order is deterministic
+
+    //seed 0 already sits on the target
+    std::vector<double> q_exact = {0.3, 0.4};
+    Vector2 target = end_effector(arm, q_exact);
+
+    std::vector<std::vector<double>> seeds = {
+        q_exact, {2.0, -1.0}, {-2.5, 1.5}, {1.0, 1.0}
+    };
+
+    auto result = IK2dMultiStart::solve(arm, target, seeds, pool);
+
+    assert(result.converged);
+    assert(result.best_seed == 0);
+    assert(result.seeds[0].converged());
+    assert(result.seeds[0].iterations == 0);
+    for (size_t k = 1; k < seeds.size(); ++k) {
+        assert(result.seeds[k].cancelled());
+        assert(result.seeds[k].iterations == 0);
+    }
+}
+
+// ----------------------------------------------
+// Test 3: Unreachable target returns the best residual
+// ----------------------------------------------
+void test_unreachable_returns_best() {
+    RobotArm2d arm{1.0, 1.0};
+    ThreadPool pool(2);
+
+    Vector2 target{3.0, 0.0};
+    auto result = IK2dMultiStart::solve(arm, target, std::vector<double>{0.1, 0.1}, 4, pool, 3, 1e-6, 100, 0.1);
+
+    assert(!result.converged);
+    for (const auto& s : result.seeds)
+        assert(result.seeds[result.best_seed].residual <= s.residual);
+
+    //closest reachable point is at full stretch
+    assert(std::abs(result.seeds[result.best_seed].residual - 1.0) < 1e-3);
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_multi_start_converges();
+    test_first_success_cancels();
+    test_unreachable_returns_best();
+
+    std::cout << "All IK2dMultiStart tests passed\n";
+    return 0;
+}
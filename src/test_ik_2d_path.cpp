@@ -0,0 +1,118 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "robot/ik_2d_path.hpp"
+#include "robot/ik_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+#include "math/se2.hpp"
+
+using robot::IK2d;
+using robot::IK2dPath;
+using robot::IK2dPathResult;
+using robot::RobotArm2d;
+using util::ThreadPool;
+using math::Vector2;
+
+static constexpr double TOL = 1e-6;
+
+// ----------------------------------------------
+// Helper: closely spaced targets on a straight line
+// ----------------------------------------------
+std::vector<Vector2> line_path(Vector2 a, Vector2 b, size_t count) {
+    std::vector<Vector2> path;
+    for (size_t i = 0; i < count; ++i) {
+        double s = static_cast<double>(i) / static_cast<double>(count - 1);
+        path.push_back(a + (b - a) * s);
+    }
+    return path;
+}
+
+// ----------------------------------------------
+// Helper: largest joint change between consecutive solutions
+// ----------------------------------------------
+double max_joint_step(const IK2dPathResult& r) {
+    double step = 0.0;
+    for (size_t i = 1; i < r.size(); ++i)
+        for (size_t j = 0; j < r.dof; ++j)
+            step = std::max(step, std::abs(r.config(i)[j] - r.config(i - 1)[j]));
+    return step;
+}
+
+// ----------------------------------------------
+// Test 1: Warm-started path solves every target
+// ----------------------------------------------
+void test_path_converges() {
+    RobotArm2d arm{1.0, 1.0};
+    auto targets = line_path({1.5, -0.5}, {0.5, 1.5}, 200);
+
+    auto r = IK2dPath::solve(arm, targets, {0.3, 0.6}, TOL, 200, 0.5);
+
+    assert(r.size() == targets.size());
+    assert(r.dof == 2);
+    for (size_t i = 0; i < r.size(); ++i) {
+        assert(r.residuals[i] < TOL);
+
+        std::vector<double> q(r.config(i), r.config(i) + r.dof);
+        Vector2 p = arm.forward_kinematics(q) * Vector2{0.0, 0.0};
+        assert(std::abs(p.x - targets[i].x) < 1e-5);
+        assert(std::abs(p.y - targets[i].y) < 1e-5);
+    }
+}
+
+// ----------------------------------------------
+// Test 2: Warm starts use fewer iterations than cold starts
+// ----------------------------------------------
+void test_warm_start_saves_iterations() {
+    //4 links: 2- and 3-link arms are solved in closed form
+    RobotArm2d arm{1.0, 0.8, 0.5, 0.3};
+    auto targets = line_path({1.8, 0.0}, {0.2, 1.6}, 100);
+    std::vector<double> q0 = {0.2, 0.2, 0.2, 0.2};
+
+    auto r = IK2dPath::solve(arm, targets, q0, TOL, 200, 0.5);
+
+    robot::IK2dWorkspace ws(arm);
+    long warm = 0, cold = 0;
+    for (size_t i = 1; i < targets.size(); ++i) {
+        warm += r.iterations[i];
+        cold += IK2d::solve(arm, targets[i], q0, ws, TOL, 200, 0.5).iterations;
+    }
+    assert(warm < cold);
+}
+
+// ----------------------------------------------
+// Test 3: Chunked solve is stitched into a continuous path
+// ----------------------------------------------
+void test_chunked_matches_serial() {
+    RobotArm2d arm{1.0, 1.0};
+    auto targets = line_path({1.5, -0.5}, {0.5, 1.5}, 300);
+    std::vector<double> q0 = {0.3, 0.6};
+
+    ThreadPool pool(4);
+    auto serial = IK2dPath::solve(arm, targets, q0, TOL, 200, 0.5);
+    auto chunked = IK2dPath::solve_chunked(arm, targets, q0, pool, 32, 1e-3, TOL, 200, 0.5);
+
+    assert(chunked.size() == serial.size());
+    for (size_t i = 0; i < chunked.size(); ++i)
+        assert(chunked.residuals[i] < TOL);
+
+    //no branch switches at chunk boundaries
+    assert(max_joint_step(chunked) < 2.0 * max_joint_step(serial) + 1e-3);
+    for (size_t i = 0; i < chunked.size(); ++i)
+        for (size_t j = 0; j < chunked.dof; ++j)
+            assert(std::abs(chunked.config(i)[j] - serial.config(i)[j]) < 1e-3);
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_path_converges();
+    test_warm_start_saves_iterations();
+    test_chunked_matches_serial();
+
+    std::cout << "All IK2dPath tests passed\n";
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#include "robot/ik_2d_step.hpp"
+#include "robot/robot_arm_2d_n.hpp"
+#include "math/se2.hpp"
+
+using robot::IK2dStep;
+using robot::IK2dStepBudget;
+using robot::IK2dStepState;
+using robot::IK2dStepStatus;
+using robot::RobotArm2dN;
+using math::Vector2;
+
+// ----------------------------------------------
+// Helper: compute end-effector position
+// ----------------------------------------------
+template <std::size_t N>
+Vector2 end_effector(const RobotArm2dN<N>& arm, const std::array<double, N>& q) {
+    return arm.forward_kinematics(q) * Vector2{0.0, 0.0};
+}
+
+// ----------------------------------------------
+// Test 1: the tick API is noexcept
+// ----------------------------------------------
+void test_noexcept() {
+    RobotArm2dN<4> arm;
+    IK2dStep ik;
+    IK2dStepState<4> s;
+    IK2dStepBudget budget;
+    static_assert(noexcept(ik.step(arm, Vector2{}, s)), "step must be noexcept");
+    static_assert(noexcept(ik.run(arm, Vector2{}, s, budget)), "run must be noexcept");
+    static_assert(std::is_trivially_copyable<IK2dStepState<4>>::value, "state must be plain data");
+}
+
+// ----------------------------------------------
+// Test 2: single steps converge to a static target
+// ----------------------------------------------
+void test_step_converges() {
+    RobotArm2dN<4> arm({0.5, 0.4, 0.3, 0.2});
+    IK2dStep ik;
+    ik.lambda = 0.05;
+
+    IK2dStepState<4> s;
+    s.q = {0.3, 0.2, -0.1, 0.4};
+    Vector2 target{0.6, 0.7};
+
+    IK2dStepStatus status = IK2dStepStatus::Stepped;
+    double prev = INFINITY;
+    int ticks = 0;
+    while (status == IK2dStepStatus::Stepped && ticks < 100) {
+        status = ik.step(arm, target, s);
+        //a step updates q by at most one update
+        assert(s.steps == static_cast<uint64_t>(ticks + (status == IK2dStepStatus::Stepped ? 1 : 0)));
+        assert(s.residual <= prev * 1.5);
+        prev = s.residual;
+        ++ticks;
+    }
+
+    assert(status == IK2dStepStatus::Converged);
+    assert(ticks < 30);
+    assert((end_effector(arm, s.q) - target).norm() < 1e-6);
+
+    //converged state is left untouched
+    auto q = s.q;
+    assert(ik.step(arm, target, s) == IK2dStepStatus::Converged);
+    assert(q == s.q);
+}
+
+// ----------------------------------------------
+// Test 3: iteration budget per tick
+// ----------------------------------------------
+void test_step_budget() {
+    RobotArm2dN<6> arm({0.3, 0.3, 0.2, 0.2, 0.1, 0.1});
+    IK2dStep ik;
+    Vector2 target{0.2, 0.8};
+
+    IK2dStepState<6> s;
+    s.q = {0.1, 0.1, 0.1, 0.1, 0.1, 0.1};
+
+    IK2dStepBudget budget;
+    budget.max_steps = 3;
+    assert(ik.run(arm, target, s, budget) == IK2dStepStatus::Stepped);
+    assert(s.steps == 3);
+
+    //a zero budget still makes progress: one update per tick
+    budget.max_steps = 0;
+    assert(ik.run(arm, target, s, budget) == IK2dStepStatus::Stepped);
+    assert(s.steps == 4);
+
+    budget.max_steps = 100;
+    assert(ik.run(arm, target, s, budget) == IK2dStepStatus::Converged);
+    assert((end_effector(arm, s.q) - target).norm() < 1e-6);
+}
+
+// ----------------------------------------------
+// Test 4: wall-clock budget per tick
+// ----------------------------------------------
+void test_time_budget() {
+    RobotArm2dN<6> arm({0.3, 0.3, 0.2, 0.2, 0.1, 0.1});
+    IK2dStep ik;
+    ik.tol = 0.0; //never converges, only the budget stops the tick
+
+    IK2dStepState<6> s;
+    s.q = {0.1, 0.1, 0.1, 0.1, 0.1, 0.1};
+
+    IK2dStepBudget budget;
+    budget.max_steps = 1 << 30;
+    budget.time = std::chrono::microseconds(200);
+
+    auto t0 = std::chrono::steady_clock::now();
+    ik.run(arm, Vector2{0.2, 0.8}, s, budget);
+    auto elapsed = std::chrono::steady_clock::now() - t0;
+
+    assert(s.steps >= 1);
+    assert(s.steps < (1u << 30));
+    //generous margin: the check runs between updates and the machine may be loaded
+    assert(elapsed < std::chrono::milliseconds(20));
+}
+
+// ----------------------------------------------
+// Test 5: singular damped system leaves q alone
+// ----------------------------------------------
+void test_step_singular() {
+    RobotArm2dN<3> arm({1.0, 1.0, 1.0});
+    IK2dStep ik;
+    ik.lambda = 0.0;
+
+    //stretched arm: every column is parallel, J J^T has rank one
+    IK2dStepState<3> s;
+    s.q = {0.0, 0.0, 0.0};
+    assert(ik.step(arm, Vector2{2.0, 0.0}, s) == IK2dStepStatus::Singular);
+    assert(s.steps == 0);
+    assert(s.q[0] == 0.0 && s.q[1] == 0.0 && s.q[2] == 0.0);
+}
+
+// ----------------------------------------------
+// Test 6: tracking a moving target, one step per tick
+// ----------------------------------------------
+void test_tracking() {
+    RobotArm2dN<5> arm({0.4, 0.3, 0.3, 0.2, 0.2});
+    IK2dStep ik;
+
+    IK2dStepState<5> s;
+    s.q = {0.4, 0.3, 0.2, 0.1, 0.1};
+
+    //settle on the start of the circle first
+    Vector2 c{0.6, 0.3};
+    double r = 0.3;
+    IK2dStepBudget settle;
+    settle.max_steps = 100;
+    ik.run(arm, c + Vector2{r, 0.0}, s, settle);
+
+    //1 kHz ticks along a circle traversed in 2 s
+    double worst = 0.0;
+    for (int tick = 1; tick <= 2000; ++tick) {
+        double a = 2.0 * M_PI * tick / 2000.0;
+        Vector2 target = c + Vector2{r * std::cos(a), r * std::sin(a)};
+        ik.step(arm, target, s);
+        worst = std::max(worst, s.residual);
+    }
+    //residual measured before each update: the target moves ~1 mm per tick
+    assert(worst < 2e-3);
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_noexcept();
+    test_step_converges();
+    test_step_budget();
+    test_time_budget();
+    test_step_singular();
+    test_tracking();
+
+    std::cout << "All IK2dStep tests passed\n";
+    return 0;
+}
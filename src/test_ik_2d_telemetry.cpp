@@ -0,0 +1,111 @@
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "robot/ik_2d.hpp"
+#include "robot/ik_2d_telemetry.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "math/se2.hpp"
+
+using robot::IK2d;
+using robot::IK2dResult;
+using robot::IK2dStatus;
+using robot::IK2dTelemetry;
+using robot::IK2dWorkspace;
+using robot::RobotArm2d;
+using math::Vector2;
+
+// ----------------------------------------------
+// Test 1: Every stop reason is reported
+// ----------------------------------------------
+void test_status_reasons() {
+    //4 links so the iterative solver runs
+    RobotArm2d arm{1.0, 0.8, 0.5, 0.3};
+    IK2dWorkspace ws(arm);
+    std::vector<double> q0 = {0.3, 0.2, 0.1, 0.1};
+
+    auto converged = IK2d::solve(arm, Vector2{1.2, 1.0}, q0, ws, 1e-6, 500, 0.5);
+    assert(converged.status == IK2dStatus::Converged);
+    assert(converged.converged());
+    assert(converged.residual < 1e-6);
+    assert(converged.iterations > 0);
+    //no sink attached: the solve is not timed
+    assert(converged.seconds == 0.0);
+
+    auto capped = IK2d::solve(arm, Vector2{1.2, 1.0}, q0, ws, 1e-6, 3, 0.1);
+    assert(capped.status == IK2dStatus::MaxIterations);
+    assert(capped.iterations == 3);
+
+    //straight arm with no damping: every column is parallel to y
+    std::vector<double> straight = {0.0, 0.0, 0.0, 0.0};
+    auto singular = IK2d::solve(arm, Vector2{1.0, 1.0}, straight, ws, 1e-6, 100, 1.0, 0.0);
+    assert(singular.status == IK2dStatus::Singular);
+    assert(singular.iterations == 0);
+
+    std::atomic<bool> stop{true};
+    ws.cancel = &stop;
+    auto cancelled = IK2d::solve(arm, Vector2{1.2, 1.0}, q0, ws);
+    assert(cancelled.status == IK2dStatus::Cancelled);
+    assert(cancelled.iterations == 0);
+    ws.cancel = nullptr;
+
+    RobotArm2d two{1.0, 1.0};
+    IK2dWorkspace ws2(two);
+    auto unreachable = IK2d::solve(two, Vector2{3.0, 0.0}, std::vector<double>{0.0, 0.0}, ws2);
+    assert(unreachable.status == IK2dStatus::Unreachable);
+    assert(std::abs(unreachable.residual - 1.0) < 1e-9);
+}
+
+// ----------------------------------------------
+// Test 2: Sink aggregates counts and histograms
+// ----------------------------------------------
+void test_sink_aggregates() {
+    RobotArm2d arm{1.0, 0.8, 0.5, 0.3};
+    IK2dWorkspace ws(arm);
+    IK2dTelemetry sink;
+    ws.telemetry = &sink;
+
+    std::vector<double> q0 = {0.3, 0.2, 0.1, 0.1};
+    uint64_t iterations = 0;
+    int converged = 0;
+
+    for (int i = 0; i < 50; ++i) {
+        Vector2 target{1.0 + 0.01 * i, 0.5};
+        IK2dResult r = IK2d::solve(arm, target, q0, ws, 1e-6, (i % 5 == 0) ? 2 : 500, 0.5);
+        iterations += static_cast<uint64_t>(r.iterations);
+        converged += r.converged() ? 1 : 0;
+    }
+
+    assert(sink.solves() == 50);
+    assert(sink.count(IK2dStatus::Converged) == static_cast<uint64_t>(converged));
+    assert(sink.count(IK2dStatus::MaxIterations) == 10);
+    assert(sink.total_iterations.load() == iterations);
+
+    uint64_t hist_total = 0;
+    for (const auto& c : sink.iteration_hist) hist_total += c.load();
+    assert(hist_total == 50);
+
+    //iterations 2 land in bucket [2, 4)
+    assert(sink.iteration_hist[IK2dTelemetry::bucket(2)].load() >= 10);
+
+    uint64_t p50 = IK2dTelemetry::quantile(sink.latency_ns_hist, 0.5);
+    uint64_t p99 = IK2dTelemetry::quantile(sink.latency_ns_hist, 0.99);
+    assert(p50 > 0 && p50 <= p99);
+    assert(sink.total_ns.load() > 0);
+
+    sink.reset();
+    assert(sink.solves() == 0);
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_status_reasons();
+    test_sink_aggregates();
+
+    std::cout << "All IK2d telemetry tests passed\n";
+    return 0;
+}
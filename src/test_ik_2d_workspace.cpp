@@ -0,0 +1,84 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "robot/ik_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "math/se2.hpp"
+
+#include "alloc_counter.hpp"
+
+using robot::IK2d;
+using robot::IK2dWorkspace;
+using robot::RobotArm2d;
+using math::Vector2;
+
+// ----------------------------------------------
+// Test 1: Workspace solve matches the plain solve
+// ----------------------------------------------
+void test_workspace_matches_plain_solve() {
+    RobotArm2d arm{1.0, 0.8, 0.5};
+    IK2dWorkspace ws(arm);
+
+    Vector2 target{1.2, 0.9};
+    std::vector<double> q0 = {0.3, 0.2, -0.1};
+
+    auto q_plain = IK2d::solve(arm, target, q0, 1e-6, 100, 0.1);
+    IK2d::solve(arm, target, q0, ws, 1e-6, 100, 0.1);
+    const auto& q_ws = ws.q;
+
+    assert(q_ws.size() == q_plain.size());
+    for (size_t i = 0; i < q_plain.size(); ++i)
+        assert(q_ws[i] == q_plain[i]);
+}
+
+// ----------------------------------------------
+// Test 2: Steady-state solves do not allocate
+// ----------------------------------------------
+void test_steady_state_zero_allocations() {
+    RobotArm2d arm{1.0, 0.8, 0.5, 0.3};
+    IK2dWorkspace ws(arm);
+
+    std::vector<double> q0 = {0.1, 0.2, 0.3, 0.4};
+    std::vector<Vector2> targets = {
+        {1.5, 0.5}, {0.5, 1.5}, {-1.0, 1.0}, {2.0, -0.3}, {5.0, 0.0}
+    };
+
+    //warm-up solve sizes every buffer
+    IK2d::solve(arm, targets[0], q0, ws, 1e-6, 200, 0.5);
+
+    size_t before = alloc_counter::allocations();
+    for (int rep = 0; rep < 10; ++rep) {
+        for (const auto& t : targets)
+            IK2d::solve(arm, t, q0, ws, 1e-6, 200, 0.5);
+    }
+    size_t after = alloc_counter::allocations();
+
+    assert(after == before);
+}
+
+// ----------------------------------------------
+// Test 3: The plain solve does allocate (counter sanity check)
+// ----------------------------------------------
+void test_counter_sees_plain_solve() {
+    RobotArm2d arm{1.0, 1.0};
+    std::vector<double> q0 = {0.5, -0.5};
+
+    size_t before = alloc_counter::allocations();
+    auto q = IK2d::solve(arm, Vector2{1.0, 1.0}, q0, 1e-6, 10, 0.1);
+    (void)q;
+    assert(alloc_counter::allocations() > before);
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_workspace_matches_plain_solve();
+    test_steady_state_zero_allocations();
+    test_counter_sees_plain_solve();
+
+    std::cout << "All IK2dWorkspace tests passed\n";
+    return 0;
+}
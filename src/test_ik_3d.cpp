@@ -0,0 +1,151 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "robot/ik_3d.hpp"
+#include "robot/robot_arm_3d.hpp"
+#include "math/se3.hpp"
+
+using robot::IK3d;
+using robot::IK3dWorkspace;
+using robot::RobotArm3d;
+using math::Matrix3;
+using math::SE3;
+using math::Vector3;
+
+//UR5-like 6-DOF arm
+RobotArm3d make_ur5() {
+    return RobotArm3d{
+        {0.0,     M_PI/2, 0.089159, 0.0},
+        {-0.425,  0.0,    0.0,      0.0},
+        {-0.39225, 0.0,   0.0,      0.0},
+        {0.0,     M_PI/2, 0.10915,  0.0},
+        {0.0,    -M_PI/2, 0.09465,  0.0},
+        {0.0,     0.0,    0.0823,   0.0}
+    };
+}
+
+double pose_distance(const SE3& A, const SE3& B) {
+    double dp = (A.t - B.t).norm();
+    double dr = IK3d::rotation_log(A.R * B.R.transpose()).norm();
+    return std::max(dp, dr);
+}
+
+// ----------------------------------------------
+// Test 1: Jacobian matches finite differences
+// ----------------------------------------------
+void test_jacobian_numerical() {
+    RobotArm3d arm = make_ur5();
+    std::vector<double> q = {0.3, -1.1, 0.7, 0.2, 1.4, -0.5};
+
+    auto J = arm.jacobian(q);
+    SE3 T = arm.forward_kinematics(q);
+
+    const double h = 1e-6;
+    for (size_t i = 0; i < q.size(); ++i) {
+        std::vector<double> qh = q;
+        qh[i] += h;
+        SE3 Th = arm.forward_kinematics(qh);
+
+        Vector3 v = (Th.t - T.t) * (1.0 / h);
+        Vector3 w = IK3d::rotation_log(Th.R * T.R.transpose()) * (1.0 / h);
+
+        assert(std::abs(v.x - J[i].linear.x) < 1e-5);
+        assert(std::abs(v.y - J[i].linear.y) < 1e-5);
+        assert(std::abs(v.z - J[i].linear.z) < 1e-5);
+        assert(std::abs(w.x - J[i].angular.x) < 1e-5);
+        assert(std::abs(w.y - J[i].angular.y) < 1e-5);
+        assert(std::abs(w.z - J[i].angular.z) < 1e-5);
+    }
+}
+
+// ----------------------------------------------
+// Test 2: Rotation log round-trips, including half turns
+// ----------------------------------------------
+void test_rotation_log() {
+    Vector3 r = IK3d::rotation_log(Matrix3::rotation_z(0.7));
+    assert(std::abs(r.z - 0.7) < 1e-12);
+
+    r = IK3d::rotation_log(Matrix3::rotation_x(M_PI));
+    assert(std::abs(std::abs(r.x) - M_PI) < 1e-9);
+    assert(std::abs(r.y) < 1e-9 && std::abs(r.z) < 1e-9);
+
+    r = IK3d::rotation_log(Matrix3::identity());
+    assert(r.norm() < 1e-12);
+}
+
+// ----------------------------------------------
+// Test 3: Full-pose targets are reached from nearby seeds
+// ----------------------------------------------
+void test_reaches_pose() {
+    RobotArm3d arm = make_ur5();
+    IK3dWorkspace ws(arm);
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> noise(-0.3, 0.3);
+
+    for (int k = 0; k < 50; ++k) {
+        std::vector<double> q_goal(6), q0(6);
+        for (size_t i = 0; i < 6; ++i) {
+            q_goal[i] = angle(rng);
+            q0[i] = q_goal[i] + noise(rng);
+        }
+        SE3 target = arm.forward_kinematics(q_goal);
+
+        auto r = IK3d::solve(arm, target, q0, ws);
+        assert(r.converged());
+        assert(r.residual < 1e-6);
+        assert(pose_distance(arm.forward_kinematics(ws.q), target) < 1e-6);
+    }
+}
+
+// ----------------------------------------------
+// Test 4: Warm starts along a path need few iterations
+// ----------------------------------------------
+void test_warm_start() {
+    RobotArm3d arm = make_ur5();
+    IK3dWorkspace ws(arm);
+
+    std::vector<double> q_goal = {0.2, -1.0, 1.2, -0.4, 0.8, 0.1};
+    auto r = IK3d::solve(arm, arm.forward_kinematics(q_goal), {0.0, -0.8, 1.0, -0.2, 0.6, 0.0}, ws);
+    assert(r.converged());
+
+    for (int step = 1; step <= 20; ++step) {
+        for (auto& v : q_goal) v += 0.01;
+        SE3 target = arm.forward_kinematics(q_goal);
+
+        r = IK3d::solve(arm, target, ws.q, ws);
+        assert(r.converged());
+        assert(r.iterations <= 5);
+    }
+}
+
+// ----------------------------------------------
+// Test 5: Unreachable position stops without converging
+// ----------------------------------------------
+void test_unreachable() {
+    RobotArm3d arm = make_ur5();
+    IK3dWorkspace ws(arm);
+
+    SE3 target(Matrix3::identity(), Vector3{5.0, 0.0, 0.0});
+    auto r = IK3d::solve(arm, target, std::vector<double>(6, 0.1), ws, 1e-6, 50);
+
+    assert(!r.converged());
+    assert(r.residual > 1.0);
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_jacobian_numerical();
+    test_rotation_log();
+    test_reaches_pose();
+    test_warm_start();
+    test_unreachable();
+
+    std::cout << "All IK3d tests passed\n";
+    return 0;
+}
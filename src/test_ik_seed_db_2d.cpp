@@ -0,0 +1,226 @@
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "robot/ik_2d.hpp"
+#include "robot/ik_seed_db_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/mapped_file.hpp"
+#include "util/thread_pool.hpp"
+
+using robot::IK2d;
+using robot::IK2dDamping;
+using robot::IK2dResult;
+using robot::IK2dWorkspace;
+using robot::IKSeedDatabase2d;
+using robot::IKSeedQuery2d;
+using robot::RobotArm2d;
+using math::Vector2;
+
+// ----------------------------------------------
+// Helper: compute end-effector position
+// ----------------------------------------------
+Vector2 end_effector(const RobotArm2d& arm, const std::vector<double>& q) {
+    return arm.forward_kinematics(q) * Vector2{0.0, 0.0};
+}
+
+// ----------------------------------------------
+// Test 1: Entries are consistent forward kinematics pairs
+// ----------------------------------------------
+void test_entries() {
+    RobotArm2d arm{0.5, 0.4, 0.3, 0.2};
+    util::ThreadPool pool(3);
+    IKSeedDatabase2d db = IKSeedDatabase2d::build(arm, 40000, pool, 3);
+    IKSeedDatabase2d serial = IKSeedDatabase2d::build(arm, 40000, 3);
+
+    assert(db.size() == 40000);
+    assert(db.dof() == 4);
+    assert(db.matches(arm));
+    for (size_t i = 0; i < db.size(); i += 97) {
+        std::vector<double> q(db.config(i), db.config(i) + 4);
+        assert((end_effector(arm, q) - db.point(i)).norm() < 1e-12);
+    }
+    //independent of the pool size
+    for (size_t i = 0; i < db.size(); ++i)
+        assert(std::equal(db.config(i), db.config(i) + 4, serial.config(i)));
+}
+
+// ----------------------------------------------
+// Test 2: k nearest match a brute-force scan
+// ----------------------------------------------
+void test_nearest() {
+    RobotArm2d arm{0.5, 0.4, 0.3};
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> coord(-1.5, 1.5);
+
+    for (size_t entries : {1, 7, 9, 1000, 20000}) {
+        IKSeedDatabase2d db = IKSeedDatabase2d::build(arm, entries);
+        IKSeedQuery2d query;
+
+        for (int t = 0; t < 50; ++t) {
+            Vector2 target{coord(rng), coord(rng)};
+
+            std::vector<double> all(entries);
+            for (size_t i = 0; i < entries; ++i)
+                all[i] = (db.point(i) - target).dot(db.point(i) - target);
+            std::sort(all.begin(), all.end());
+
+            for (size_t k : {1, 5, 32}) {
+                const size_t found = db.nearest(target, k, query);
+                assert(found == std::min(k, entries));
+                assert(query.index.size() == found && query.d2.size() == found);
+                for (size_t j = 0; j < found; ++j) {
+                    assert(query.d2[j] == all[j]);
+                    const Vector2 d = db.point(query.index[j]) - target;
+                    assert(d.dot(d) == query.d2[j]);
+                }
+            }
+        }
+    }
+
+    IKSeedDatabase2d db = IKSeedDatabase2d::build(arm, 10);
+    IKSeedQuery2d query;
+    assert(db.nearest(Vector2{0.1, 0.1}, 0, query) == 0);
+}
+
+// ----------------------------------------------
+// Test 3: Seeds cut IK iterations
+// ----------------------------------------------
+void test_seeded_solve() {
+    RobotArm2d arm{0.3, 0.3, 0.2, 0.2, 0.1, 0.1};
+    IKSeedDatabase2d db = IKSeedDatabase2d::build(arm, 100000);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    IK2dWorkspace ws(arm);
+    IKSeedQuery2d query;
+    const std::vector<double> q0(6, 0.3);
+
+    std::vector<int> seeded, seeded_adaptive, fixed, adaptive;
+    for (int t = 0; t < 200; ++t) {
+        std::vector<double> q(6);
+        for (auto& v : q) v = angle(rng);
+        const Vector2 target = end_effector(arm, q);
+
+        IK2dResult r = db.solve(arm, target, ws, query, 4);
+        assert(r.converged());
+        assert((end_effector(arm, ws.q) - target).norm() < 1e-6);
+        seeded.push_back(r.iterations);
+        r = db.solve(arm, target, ws, query, 4, 1e-6, 100, 1.0, 0.1, IK2dDamping::Adaptive);
+        assert(r.converged());
+        seeded_adaptive.push_back(r.iterations);
+
+        //an arbitrary q0, with the default and the adaptive damping
+        r = IK2d::solve(arm, target, q0, ws);
+        fixed.push_back(r.converged() ? r.iterations : 100);
+        r = IK2d::solve(arm, target, q0, ws, 1e-6, 100, 1.0, 0.1, IK2dDamping::Adaptive);
+        adaptive.push_back(r.converged() ? r.iterations : 100);
+    }
+    auto median = [](std::vector<int> v) {
+        std::sort(v.begin(), v.end());
+        return v[v.size() / 2];
+    };
+    //both damping modes gain from a seed
+    assert(median(seeded) <= 4 && median(seeded_adaptive) <= 4);
+    assert(median(seeded) < median(fixed));
+    assert(median(seeded_adaptive) < median(adaptive));
+}
+
+// ----------------------------------------------
+// Test 4: Save and memory-map back
+// ----------------------------------------------
+void test_save_load() {
+    RobotArm2d arm{0.5, 0.4, 0.3};
+    IKSeedDatabase2d db = IKSeedDatabase2d::build(arm, 5000);
+
+    const std::string path = "test_ik_seed_db_2d.bin";
+    assert(db.save(path));
+
+    IKSeedDatabase2d loaded;
+    assert(loaded.empty());
+    assert(IKSeedDatabase2d::load(path, loaded));
+    assert(loaded.size() == db.size());
+    assert(loaded.matches(arm));
+    for (size_t i = 0; i < db.size(); ++i) {
+        assert((loaded.point(i) - db.point(i)).norm() == 0.0);
+        assert(std::equal(db.config(i), db.config(i) + 3, loaded.config(i)));
+    }
+
+    //queries run on the mapping
+    IKSeedQuery2d a, b;
+    loaded.nearest(Vector2{0.4, -0.3}, 8, a);
+    db.nearest(Vector2{0.4, -0.3}, 8, b);
+    assert(a.index == b.index);
+
+    //truncated
+    util::MappedFile file;
+    assert(file.open(path));
+    std::vector<char> bytes(file.data(), file.data() + file.size());
+    file.close();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+    IKSeedDatabase2d bad;
+    assert(!IKSeedDatabase2d::load(path, bad));
+    assert(bad.empty());
+
+    //wrong magic
+    bytes[0] = 'X';
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    assert(!IKSeedDatabase2d::load(path, bad));
+    std::remove(path.c_str());
+}
+
+// ----------------------------------------------
+// Test 5: Without a seed the solve starts from ws.q
+// ----------------------------------------------
+void test_no_seed() {
+    RobotArm2d arm{0.5, 0.4, 0.3, 0.2};
+    const Vector2 target = end_effector(arm, {0.4, -0.3, 0.8, 0.2});
+    IKSeedQuery2d query;
+
+    IKSeedDatabase2d empty;
+    IKSeedDatabase2d db = IKSeedDatabase2d::build(arm, 1000);
+    for (const IKSeedDatabase2d* d : {&empty, &db}) {
+        const size_t k = d->empty() ? 4 : 0;
+
+        IK2dWorkspace ws(arm);
+        ws.q = {0.3, 0.3, 0.3, 0.3};
+        IK2dResult r = d->solve(arm, target, ws, query, k);
+        IK2dResult ref = IK2d::solve(arm, target, std::vector<double>(4, 0.3), ws);
+        assert(r.converged());
+        assert(r.status == ref.status && r.iterations == ref.iterations);
+        assert((end_effector(arm, ws.q) - target).norm() < 1e-6);
+
+        //unreachable: a real residual, not a default result
+        IK2dWorkspace far_ws;
+        r = d->solve(arm, Vector2{3.0, 0.0}, far_ws, query, k);
+        assert(!r.converged());
+        assert(far_ws.q.size() == 4);
+        assert(std::abs(r.residual - (3.0 - 1.4)) < 1e-3);
+    }
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_entries();
+    test_nearest();
+    test_seeded_solve();
+    test_save_load();
+    test_no_seed();
+
+    std::cout << "All IKSeedDatabase2d tests passed\n";
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <random>
 #include <vector>
 
 #include "robot/jacobian_2d.hpp"
@@ -14,25 +15,38 @@ using math::Vector2;
 static constexpr double EPS = 1e-6;
 
 // ------------------------------------------------------------
-// Helper: numerical finite-difference Jacobian for validation
+// Helper: RobotArm2d configuration whose link angles are the
+// relative-convention angles r (joint i of the arm rotates by
+// q1 + ... + qi, so q_i = r_i - r_i-1)
+// ------------------------------------------------------------
+std::vector<double> arm_config(const std::vector<double>& r) {
+    std::vector<double> q(r.size());
+    for (size_t i = 0; i < r.size(); ++i)
+        q[i] = r[i] - (i > 0 ? r[i - 1] : 0.0);
+    return q;
+}
+
+// ------------------------------------------------------------
+// Helper: numerical finite-difference Jacobian for validation,
+// with respect to the relative angles r
 // ------------------------------------------------------------
 std::vector<std::vector<double>>
 numerical_jacobian(const RobotArm2d& arm,
-                   const std::vector<double>& q,
+                   const std::vector<double>& r,
                    double h = 1e-6)
 {
-    size_t N = q.size();
+    size_t N = r.size();
     std::vector<std::vector<double>> J(2, std::vector<double>(N, 0.0));
 
     //Current end-effector position
-    auto T0 = arm.forward_kinematics(q);
+    auto T0 = arm.forward_kinematics(arm_config(r));
     Vector2 p0 = T0 * Vector2{0.0, 0.0};
 
     for (size_t i = 0; i < N; ++i) {
-        std::vector<double> q_perturbed = q;
-        q_perturbed[i] += h;
+        std::vector<double> r_perturbed = r;
+        r_perturbed[i] += h;
 
-        auto T1 = arm.forward_kinematics(q_perturbed);
+        auto T1 = arm.forward_kinematics(arm_config(r_perturbed));
         Vector2 p1 = T1 * Vector2{0.0, 0.0};
 
         J[0][i] = (p1.x - p0.x) / h;
@@ -41,6 +55,24 @@ numerical_jacobian(const RobotArm2d& arm,
     return J;
 }
 
+// ------------------------------------------------------------
+// Helper: reference O(N^2) Jacobian, every column summed directly
+// ------------------------------------------------------------
+std::vector<std::vector<double>>
+reference_jacobian(const std::vector<double>& L, const std::vector<double>& r) {
+    size_t N = L.size();
+    std::vector<std::vector<double>> J(2, std::vector<double>(N, 0.0));
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t k = i; k < N; ++k) {
+            double angle = 0.0;
+            for (size_t j = 0; j <= k; ++j) angle += r[j];
+            J[0][i] += -L[k] * std::sin(angle);
+            J[1][i] += L[k] * std::cos(angle);
+        }
+    }
+    return J;
+}
+
 // ----------------------------------------
 // Test 1: Straight arm (all angles = 0)
 // ----------------------------------------
@@ -111,6 +143,117 @@ void test_jacobian_numerical() {
     }
 }
 
+// -----------------------------------------------
+// Test 4: O(N) kernel matches the direct sums
+// -----------------------------------------------
+void test_jacobian_reference() {
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> length(0.1, 1.0);
+
+    for (size_t N : {1, 2, 7, 64}) {
+        std::vector<double> L(N), r(N);
+        for (auto& v : L) v = length(rng);
+        for (auto& v : r) v = angle(rng);
+
+        auto J = Jacobian2d::compute(L, r);
+        auto J_ref = reference_jacobian(L, r);
+
+        //row-major buffer variant, plus the end effector it returns
+        std::vector<double> buf(2 * N);
+        Vector2 tip = Jacobian2d::compute(L, r, buf.data());
+
+        RobotArm2d arm{};
+        arm.link_lengths = L;
+        Vector2 p = arm.forward_kinematics(arm_config(r)) * Vector2{0.0, 0.0};
+        assert((tip - p).norm() < 1e-9);
+
+        for (size_t i = 0; i < N; ++i) {
+            assert(std::abs(J[0][i] - J_ref[0][i]) < 1e-9);
+            assert(std::abs(J[1][i] - J_ref[1][i]) < 1e-9);
+            assert(buf[i] == J[0][i]);
+            assert(buf[N + i] == J[1][i]);
+        }
+    }
+}
+
+// -----------------------------------------------
+// Test 5: Jacobian2d and RobotArm2d agree
+// -----------------------------------------------
+void test_jacobian_arm_consistency() {
+    //RobotArm2d columns are taken with respect to the cumulative joint
+    //rotations c_i = q1 + ... + qi; those are Jacobian2d's relative angles
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    for (size_t N : {2, 5, 32}) {
+        RobotArm2d arm{};
+        arm.link_lengths.assign(N, 1.0 / static_cast<double>(N));
+
+        std::vector<double> q(N), c(N);
+        for (auto& v : q) v = angle(rng);
+        double sum = 0.0;
+        for (size_t i = 0; i < N; ++i) c[i] = sum += q[i];
+
+        auto J_arm = arm.jacobian(q);
+        auto J = Jacobian2d::compute(arm.link_lengths, c);
+
+        std::vector<double> buf(2 * N);
+        Jacobian2d::compute(arm.link_lengths, q, buf.data(), robot::JointAngles::Cumulative);
+
+        for (size_t i = 0; i < N; ++i) {
+            assert(std::abs(J_arm[i].x - J[0][i]) < 1e-12);
+            assert(std::abs(J_arm[i].y - J[1][i]) < 1e-12);
+            assert(buf[i] == J_arm[i].x && buf[N + i] == J_arm[i].y);
+        }
+
+        //the fused kernel's joints and pose still match the plain FK
+        std::vector<Vector2> joints, J_fused;
+        auto T = arm.kinematics(q, joints, J_fused);
+        auto T_fk = arm.forward_kinematics(q);
+        auto joints_fk = arm.joint_positions(q);
+        assert((T.t - T_fk.t).norm() < 1e-12);
+        assert(std::abs(T.R.m00 - T_fk.R.m00) < 1e-12 && std::abs(T.R.m10 - T_fk.R.m10) < 1e-12);
+        for (size_t i = 0; i < N; ++i)
+            assert((joints[i] - joints_fk[i]).norm() < 1e-12);
+    }
+}
+
+// -----------------------------------------------
+// Test 6: CumulativeDq columns are dp/dq of the arm
+// -----------------------------------------------
+void test_jacobian_arm_dq() {
+    std::mt19937 rng(6);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    const double h = 1e-6;
+
+    for (size_t N : {1, 2, 5, 32}) {
+        RobotArm2d arm{};
+        arm.link_lengths.assign(N, 1.0 / static_cast<double>(N));
+
+        std::vector<double> q(N);
+        for (auto& v : q) v = angle(rng);
+
+        std::vector<Vector2> J(N), J_dc(N);
+        auto tip = Jacobian2d::kernel(arm.link_lengths.data(), q.data(), N,
+                                      robot::JointAngles::CumulativeDq, &J[0].x, &J[0].y, 2);
+        auto tip_dc = Jacobian2d::kernel(arm.link_lengths.data(), q.data(), N,
+                                         robot::JointAngles::Cumulative, &J_dc[0].x, &J_dc[0].y, 2);
+
+        //same end effector in both modes
+        Vector2 p0 = arm.forward_kinematics(q) * Vector2{0.0, 0.0};
+        assert((tip.p - p0).norm() < 1e-12);
+        assert(tip.p.x == tip_dc.p.x && tip.p.y == tip_dc.p.y);
+
+        for (size_t i = 0; i < N; ++i) {
+            std::vector<double> q1 = q;
+            q1[i] += h;
+            Vector2 d = (arm.forward_kinematics(q1) * Vector2{0.0, 0.0} - p0) * (1.0 / h);
+            assert((J[i] - d).norm() < 1e-4);
+        }
+    }
+}
+
 // -----------------------------------------------
 // Main
 // -----------------------------------------------
@@ -118,6 +261,9 @@ int main() {
     test_jacobian_straight();
     test_jacobian_right_angle();
     test_jacobian_numerical();
+    test_jacobian_reference();
+    test_jacobian_arm_consistency();
+    test_jacobian_arm_dq();
 
     std::cout << "All Jacobian2d tests passed\n";
     return 0;
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "math/vector3.hpp"
+#include "math/matrix3.hpp"
+#include "math/se3.hpp"
+#include "math/quaternion.hpp"
+#include "math/se3_quat.hpp"
+
+using math::Matrix3;
+using math::Quaternion;
+using math::SE3;
+using math::SE3Quat;
+using math::Vector3;
+
+static constexpr double EPS = 1e-12;
+
+bool matrix_near(const Matrix3& A, const Matrix3& B, double eps) {
+    return std::abs(A.m00 - B.m00) < eps && std::abs(A.m01 - B.m01) < eps && std::abs(A.m02 - B.m02) < eps &&
+           std::abs(A.m10 - B.m10) < eps && std::abs(A.m11 - B.m11) < eps && std::abs(A.m12 - B.m12) < eps &&
+           std::abs(A.m20 - B.m20) < eps && std::abs(A.m21 - B.m21) < eps && std::abs(A.m22 - B.m22) < eps;
+}
+
+Matrix3 random_rotation(std::mt19937& rng) {
+    std::uniform_real_distribution<double> a(-M_PI, M_PI);
+    return Matrix3::rotation_z(a(rng)) * Matrix3::rotation_y(a(rng)) * Matrix3::rotation_x(a(rng));
+}
+
+// ------------------------
+// Quaternion Tests
+// ------------------------
+
+void test_axis_angle_matches_matrix() {
+    Quaternion q = Quaternion::from_axis_angle(Vector3{0.0, 0.0, 1.0}, 0.8);
+    assert(matrix_near(q.to_matrix(), Matrix3::rotation_z(0.8), EPS));
+
+    Vector3 r = Quaternion::from_axis_angle(Vector3{1.0, 0.0, 0.0}, M_PI / 2.0) * Vector3{0.0, 1.0, 0.0};
+    assert(std::abs(r.x) < 1e-9 && std::abs(r.y) < 1e-9 && std::abs(r.z - 1.0) < 1e-9);
+}
+
+void test_matrix_round_trip() {
+    std::mt19937 rng(5);
+    for (int k = 0; k < 200; ++k) {
+        Matrix3 R = random_rotation(rng);
+        Quaternion q = Quaternion::from_matrix(R);
+        assert(std::abs(q.norm() - 1.0) < EPS);
+        assert(matrix_near(q.to_matrix(), R, 1e-12));
+    }
+
+    //half turns exercise the non-trace branches
+    for (const Matrix3& R : {Matrix3::rotation_x(M_PI), Matrix3::rotation_y(M_PI), Matrix3::rotation_z(M_PI)})
+        assert(matrix_near(Quaternion::from_matrix(R).to_matrix(), R, 1e-12));
+}
+
+void test_compose_matches_matrix_product() {
+    std::mt19937 rng(6);
+    for (int k = 0; k < 100; ++k) {
+        Matrix3 A = random_rotation(rng), B = random_rotation(rng);
+        Quaternion qa = Quaternion::from_matrix(A), qb = Quaternion::from_matrix(B);
+
+        assert(matrix_near((qa * qb).to_matrix(), A * B, 1e-12));
+
+        Vector3 v{0.3, -1.2, 2.0};
+        Vector3 r1 = A * v, r2 = qa * v;
+        assert((r1 - r2).norm() < 1e-12);
+    }
+}
+
+void test_renormalize() {
+    Quaternion q(1.0001 * 0.5, 1.0001 * 0.5, 1.0001 * 0.5, 1.0001 * 0.5);
+    q.renormalize();
+    q.renormalize();
+    assert(std::abs(q.norm() - 1.0) < 1e-12);
+
+    //long composition chains stay unit with periodic renormalization
+    Quaternion step = Quaternion::from_axis_angle(Vector3{0.6, 0.0, 0.8}, 0.001);
+    Quaternion acc;
+    for (int i = 1; i <= 100000; ++i) {
+        acc = acc * step;
+        if (i % 32 == 0) acc.renormalize();
+    }
+    assert(std::abs(acc.norm() - 1.0) < 1e-12);
+}
+
+void test_batched_conversions() {
+    std::mt19937 rng(7);
+    std::vector<Matrix3> R(17), back(17);
+    std::vector<Quaternion> q(17);
+    for (auto& m : R) m = random_rotation(rng);
+
+    math::from_matrices(R.data(), q.data(), R.size());
+    math::to_matrices(q.data(), back.data(), q.size());
+
+    for (size_t i = 0; i < R.size(); ++i)
+        assert(matrix_near(R[i], back[i], 1e-12));
+}
+
+// ------------------------
+// SE3Quat Tests
+// ------------------------
+
+void test_se3_quat_matches_se3() {
+    std::mt19937 rng(8);
+    SE3 A(random_rotation(rng), Vector3{1.0, 2.0, 3.0});
+    SE3 B(random_rotation(rng), Vector3{-0.5, 0.1, 0.7});
+    SE3Quat a(A), b(B);
+
+    SE3 AB = A * B;
+    SE3 ab = (a * b).to_se3();
+    assert(matrix_near(AB.R, ab.R, 1e-12));
+    assert((AB.t - ab.t).norm() < 1e-12);
+
+    Vector3 p{0.4, -0.3, 1.5};
+    assert(((A * p) - (a * p)).norm() < 1e-12);
+
+    SE3 Ai = A.inverse();
+    SE3 ai = a.inverse().to_se3();
+    assert(matrix_near(Ai.R, ai.R, 1e-12));
+    assert((Ai.t - ai.t).norm() < 1e-12);
+
+    std::vector<SE3> poses = {A, B, AB}, out(3);
+    std::vector<SE3Quat> compact(3);
+    math::from_se3(poses.data(), compact.data(), 3);
+    math::to_se3(compact.data(), out.data(), 3);
+    for (size_t i = 0; i < 3; ++i) {
+        assert(matrix_near(poses[i].R, out[i].R, 1e-12));
+        assert((poses[i].t - out[i].t).norm() < 1e-12);
+    }
+}
+
+int main() {
+    test_axis_angle_matches_matrix();
+    test_matrix_round_trip();
+    test_compose_matches_matrix_product();
+    test_renormalize();
+    test_batched_conversions();
+    test_se3_quat_matches_se3();
+
+    std::cout << "All Quaternion tests passed\n";
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "robot/reachability_map_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/mapped_file.hpp"
+#include "util/thread_pool.hpp"
+
+using robot::ReachabilityMap2d;
+using robot::RobotArm2d;
+using math::Vector2;
+
+// ----------------------------------------------
+// Test 1: Annulus workspace of a two-link arm
+// ----------------------------------------------
+void test_annulus() {
+    //reachable for 0.4 <= |p| <= 1.6
+    RobotArm2d arm{1.0, 0.6};
+    ReachabilityMap2d map = ReachabilityMap2d::build(arm, 0.05, 1 << 20);
+
+    assert(!map.empty());
+    assert(map.matches(arm));
+    assert(!map.matches(RobotArm2d{1.0, 0.5}));
+    assert(map.width() * map.resolution() >= 3.2);
+
+    size_t wrong = 0, checked = 0;
+    for (double r = 0.0; r < 2.0; r += 0.013) {
+        for (double a = 0.0; a < 2.0 * M_PI; a += 0.1) {
+            Vector2 p{r * std::cos(a), r * std::sin(a)};
+            //skip the cells straddling either boundary
+            if (std::abs(r - 0.4) < 0.08 || std::abs(r - 1.6) < 0.08)
+                continue;
+            const bool inside = r > 0.4 && r < 1.6;
+            wrong += map.reachable(p) != inside ? 1 : 0;
+            ++checked;
+            if (!inside)
+                assert(map.manipulability(p) == 0.0);
+        }
+    }
+    assert(checked > 1000);
+    assert(wrong == 0);
+
+    //off the grid
+    assert(!map.reachable(Vector2{10.0, 0.0}));
+    assert(map.hits(Vector2{-10.0, 3.0}) == 0);
+
+    //two links: |det J| = L1 L2 |sin q2|, best mid-workspace, zero at the rims
+    assert(std::abs(map.max_manipulability() - 0.6) < 0.01);
+    assert(map.manipulability(Vector2{1.15, 0.02}) > 0.55);
+    assert(map.manipulability(Vector2{0.0, 1.57}) < map.manipulability(Vector2{0.0, 1.15}));
+}
+
+// ----------------------------------------------
+// Test 2: The map does not depend on the pool size
+// ----------------------------------------------
+void test_deterministic() {
+    RobotArm2d arm{0.5, 0.4, 0.3};
+    const uint64_t samples = 300000; //several chunks, last one partial
+
+    ReachabilityMap2d serial = ReachabilityMap2d::build(arm, 0.04, samples, 7);
+    util::ThreadPool pool(3);
+    ReachabilityMap2d parallel = ReachabilityMap2d::build(arm, 0.04, samples, pool, 7);
+
+    const size_t cells = serial.width() * serial.height();
+    assert(parallel.width() * parallel.height() == cells);
+    uint64_t total = 0;
+    for (size_t i = 0; i < cells; ++i) {
+        assert(serial.hits_data()[i] == parallel.hits_data()[i]);
+        assert(serial.manipulability_data()[i] == parallel.manipulability_data()[i]);
+        total += serial.hits_data()[i];
+    }
+    //every sample lands on the grid
+    assert(total == samples);
+}
+
+// ----------------------------------------------
+// Test 3: Save and memory-map back
+// ----------------------------------------------
+void test_save_load() {
+    RobotArm2d arm{0.5, 0.4, 0.3};
+    ReachabilityMap2d map = ReachabilityMap2d::build(arm, 0.03, 200000);
+
+    const std::string path = "test_reachability_map_2d.rmap";
+    assert(map.save(path));
+
+    ReachabilityMap2d loaded;
+    assert(loaded.empty());
+    assert(ReachabilityMap2d::load(path, loaded));
+    assert(loaded.width() == map.width() && loaded.height() == map.height());
+    assert(loaded.resolution() == map.resolution());
+    assert(loaded.samples() == map.samples());
+    assert(loaded.max_manipulability() == map.max_manipulability());
+    assert(loaded.matches(arm));
+
+    for (double x = -1.3; x < 1.3; x += 0.017) {
+        for (double y = -1.3; y < 1.3; y += 0.019) {
+            Vector2 p{x, y};
+            assert(loaded.hits(p) == map.hits(p));
+            assert(loaded.manipulability(p) == map.manipulability(p));
+        }
+    }
+
+    //moving keeps the mapping alive
+    ReachabilityMap2d moved = std::move(loaded);
+    assert(moved.hits(Vector2{0.6, 0.1}) == map.hits(Vector2{0.6, 0.1}));
+
+    //truncated
+    util::MappedFile file;
+    assert(file.open(path));
+    std::vector<char> bytes(file.data(), file.data() + file.size());
+    file.close();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 4));
+    }
+    ReachabilityMap2d bad;
+    assert(!ReachabilityMap2d::load(path, bad));
+    assert(bad.empty());
+
+    //wrong version
+    bytes[4] = 99;
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    assert(!ReachabilityMap2d::load(path, bad));
+
+    assert(!ReachabilityMap2d::load("does_not_exist.rmap", bad));
+    std::remove(path.c_str());
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_annulus();
+    test_deterministic();
+    test_save_load();
+
+    std::cout << "All ReachabilityMap2d tests passed\n";
+    return 0;
+}
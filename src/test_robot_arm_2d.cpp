@@ -1,6 +1,8 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <random>
+#include <vector>
 
 #include "robot/robot_arm_2d.hpp"
 #include "math/se2.hpp"
@@ -85,6 +87,85 @@ void test_fk_cumulative() {
     assert(std::abs(p.y - 3.0) < 1e-6);
 }
 
+void test_fk_batch_matches_scalar() {
+    RobotArm2d arm{1.0, 0.8, 0.6, 0.4, 0.2};
+    const size_t N = arm.link_lengths.size();
+    const size_t B = 300; //spans more than one internal tile
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    //joint-major structure-of-arrays input
+    std::vector<double> q(N * B);
+    for (auto& v : q) v = angle(rng);
+
+    std::vector<double> x(B), y(B), theta(B);
+    std::vector<double> jx(N * B), jy(N * B);
+    arm.forward_kinematics_batch(q.data(), B, x.data(), y.data(), theta.data(),
+                                 jx.data(), jy.data());
+
+    std::vector<double> qb(N);
+    for (size_t b = 0; b < B; ++b) {
+        for (size_t i = 0; i < N; ++i) qb[i] = q[i * B + b];
+
+        auto T = arm.forward_kinematics(qb);
+        assert(std::abs(T.t.x - x[b]) < EPS);
+        assert(std::abs(T.t.y - y[b]) < EPS);
+        assert(std::abs(T.R.m00 - std::cos(theta[b])) < EPS);
+        assert(std::abs(T.R.m10 - std::sin(theta[b])) < EPS);
+
+        auto joints = arm.joint_positions(qb);
+        for (size_t i = 0; i < N; ++i) {
+            assert(std::abs(joints[i].x - jx[i * B + b]) < EPS);
+            assert(std::abs(joints[i].y - jy[i * B + b]) < EPS);
+        }
+    }
+}
+
+void test_fk_batch_without_joints() {
+    RobotArm2d arm{1.0, 1.0, 1.0};
+
+    //two configurations: {pi/2, -pi/2, 0} and {0, 0, 0}
+    std::vector<double> q = {M_PI/2, 0.0,
+                             -M_PI/2, 0.0,
+                             0.0, 0.0};
+    double x[2], y[2], theta[2];
+    arm.forward_kinematics_batch(q.data(), 2, x, y, theta);
+
+    assert(std::abs(x[0] - 0.0) < 1e-6);
+    assert(std::abs(y[0] - 3.0) < 1e-6);
+    assert(std::abs(x[1] - 3.0) < EPS);
+    assert(std::abs(y[1] - 0.0) < EPS);
+}
+
+void test_fused_kinematics_matches_separate_calls() {
+    RobotArm2d arm{1.0, 0.7, 0.5, 0.3};
+    std::vector<double> q = {0.4, -1.1, 0.9, 2.3};
+
+    //reference: composed SE2 transforms
+    auto T_ref = arm.forward_kinematics(q);
+    auto joints_ref = arm.joint_positions(q);
+
+    std::vector<Vector2> joints, J;
+    auto T = arm.kinematics(q, joints, J);
+
+    assert(std::abs(T.t.x - T_ref.t.x) < EPS);
+    assert(std::abs(T.t.y - T_ref.t.y) < EPS);
+    assert(std::abs(T.R.m00 - T_ref.R.m00) < EPS);
+    assert(std::abs(T.R.m01 - T_ref.R.m01) < EPS);
+    assert(std::abs(T.R.m10 - T_ref.R.m10) < EPS);
+    assert(std::abs(T.R.m11 - T_ref.R.m11) < EPS);
+
+    for (size_t j = 0; j < q.size(); ++j) {
+        assert(std::abs(joints[j].x - joints_ref[j].x) < EPS);
+        assert(std::abs(joints[j].y - joints_ref[j].y) < EPS);
+
+        //z-hat cross (p_end - p_j)
+        assert(std::abs(J[j].x + (T_ref.t.y - joints_ref[j].y)) < EPS);
+        assert(std::abs(J[j].y - (T_ref.t.x - joints_ref[j].x)) < EPS);
+    }
+}
+
 int main() {
     test_fk_two_links_straight();
     test_fk_three_links_straight();
@@ -92,6 +173,9 @@ int main() {
     test_fk_three_links_mixed_angles();
     test_fk_angles();
     test_fk_cumulative();
+    test_fk_batch_matches_scalar();
+    test_fk_batch_without_joints();
+    test_fused_kinematics_matches_separate_calls();
 
     std::cout << "All RobotArm2d tests passed\n";
     return 0;
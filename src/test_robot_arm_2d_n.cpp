@@ -0,0 +1,147 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "robot/robot_arm_2d_n.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "robot/ik_2d.hpp"
+#include "math/se2.hpp"
+
+using robot::IK2d;
+using robot::IK2dWorkspace;
+using robot::RobotArm2d;
+using robot::RobotArm2dN;
+using math::Vector2;
+
+static constexpr double EPS = 1e-9;
+
+// ------------------------------------------------------------
+// Helper: random link lengths and joint angles for an N-link arm
+// ------------------------------------------------------------
+template <std::size_t N>
+RobotArm2dN<N> random_arm(std::mt19937& rng) {
+    std::uniform_real_distribution<double> length(0.2, 1.0);
+    std::array<double, N> L;
+    for (auto& l : L) l = length(rng);
+    return RobotArm2dN<N>(L);
+}
+
+template <std::size_t N>
+std::array<double, N> random_config(std::mt19937& rng) {
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::array<double, N> q;
+    for (auto& v : q) v = angle(rng);
+    return q;
+}
+
+// ------------------------------------------------------------
+// Test 1: Compile-time queries
+// ------------------------------------------------------------
+void test_constexpr_queries() {
+    constexpr RobotArm2dN<3> arm(std::array<double, 3>{1.0, 0.5, 0.25});
+    static_assert(RobotArm2dN<3>::dof() == 3, "dof");
+    static_assert(arm.reach() == 1.75, "reach");
+}
+
+// ------------------------------------------------------------
+// Test 2: Straight arm FK
+// ------------------------------------------------------------
+void test_fk_straight() {
+    RobotArm2dN<2> arm({1.0, 1.0});
+    auto T = arm.forward_kinematics({0.0, 0.0});
+    Vector2 p = T * Vector2{0.0, 0.0};
+
+    assert(std::abs(p.x - 2.0) < EPS);
+    assert(std::abs(p.y - 0.0) < EPS);
+}
+
+// ------------------------------------------------------------
+// Test 3: FK, joint positions and Jacobian match RobotArm2d
+// ------------------------------------------------------------
+template <std::size_t N>
+void test_matches_dynamic() {
+    std::mt19937 rng(static_cast<unsigned>(N));
+    auto arm = random_arm<N>(rng);
+    RobotArm2d dyn = arm.to_dynamic();
+
+    for (int trial = 0; trial < 20; ++trial) {
+        auto q = random_config<N>(rng);
+        std::vector<double> qv(q.begin(), q.end());
+
+        auto T = arm.forward_kinematics(q);
+        auto T_ref = dyn.forward_kinematics(qv);
+        assert(std::abs(T.t.x - T_ref.t.x) < EPS);
+        assert(std::abs(T.t.y - T_ref.t.y) < EPS);
+        assert(std::abs(T.R.m00 - T_ref.R.m00) < EPS);
+        assert(std::abs(T.R.m10 - T_ref.R.m10) < EPS);
+
+        auto joints = arm.joint_positions(q);
+        auto joints_ref = dyn.joint_positions(qv);
+        auto J = arm.jacobian(q);
+        auto J_ref = dyn.jacobian(qv);
+        for (std::size_t i = 0; i < N; ++i) {
+            assert(std::abs(joints[i].x - joints_ref[i].x) < EPS);
+            assert(std::abs(joints[i].y - joints_ref[i].y) < EPS);
+            assert(std::abs(J[i].x - J_ref[i].x) < EPS);
+            assert(std::abs(J[i].y - J_ref[i].y) < EPS);
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// Test 4: Fixed-DOF IK follows the dynamic solver
+// ------------------------------------------------------------
+template <std::size_t N>
+void test_ik_matches_dynamic() {
+    std::mt19937 rng(100 + static_cast<unsigned>(N));
+    auto arm = random_arm<N>(rng);
+    RobotArm2d dyn = arm.to_dynamic();
+    IK2dWorkspace ws(dyn);
+
+    for (int trial = 0; trial < 10; ++trial) {
+        //target generated from a random configuration is always reachable
+        auto T_goal = arm.forward_kinematics(random_config<N>(rng));
+        Vector2 target = T_goal * Vector2{0.0, 0.0};
+
+        auto q0 = random_config<N>(rng);
+        std::vector<double> q0v(q0.begin(), q0.end());
+
+        auto r = IK2d::solve(arm, target, q0, 1e-9, 50, 0.5);
+        auto r_ref = IK2d::solve(dyn, target, q0v, ws, 1e-9, 50, 0.5);
+
+        assert(r.status == r_ref.status && r.iterations == r_ref.iterations);
+        assert(std::abs(r.residual - r_ref.residual) < 1e-9);
+        for (std::size_t i = 0; i < N; ++i)
+            assert(std::abs(r.q[i] - ws.q[i]) < 1e-6);
+    }
+
+    //beyond the reach: same status and residual as the dynamic solve
+    Vector2 far{2.0 * arm.reach(), 0.0};
+    auto q0 = random_config<N>(rng);
+    auto r = IK2d::solve(arm, far, q0, 1e-9, 50, 0.5);
+    auto r_ref = IK2d::solve(dyn, far, std::vector<double>(q0.begin(), q0.end()), ws, 1e-9, 50, 0.5);
+    assert(!r.converged() && r.status == r_ref.status);
+    assert(std::abs(r.residual - r_ref.residual) < 1e-6);
+}
+
+// ------------------------------------------------------------
+// Main
+// ------------------------------------------------------------
+int main() {
+    test_constexpr_queries();
+    test_fk_straight();
+
+    test_matches_dynamic<2>();
+    test_matches_dynamic<3>();
+    test_matches_dynamic<6>();
+    test_matches_dynamic<7>();
+
+    test_ik_matches_dynamic<2>();
+    test_ik_matches_dynamic<3>();
+    test_ik_matches_dynamic<6>();
+
+    std::cout << "All RobotArm2dN tests passed\n";
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "robot/robot_arm_3d.hpp"
+#include "math/se3.hpp"
+
+using robot::DHParams;
+using robot::RobotArm3d;
+using math::Matrix3;
+using math::SE3;
+using math::Vector3;
+
+static constexpr double EPS = 1e-9;
+
+//UR5-like 6-DOF arm
+RobotArm3d make_ur5() {
+    return RobotArm3d{
+        {0.0,     M_PI/2, 0.089159, 0.0},
+        {-0.425,  0.0,    0.0,      0.0},
+        {-0.39225, 0.0,   0.0,      0.0},
+        {0.0,     M_PI/2, 0.10915,  0.0},
+        {0.0,    -M_PI/2, 0.09465,  0.0},
+        {0.0,     0.0,    0.0823,   0.0}
+    };
+}
+
+// ----------------------------------------------
+// Helper: reference FK composing the four DH factors as SE3
+// ----------------------------------------------
+SE3 reference_fk(const RobotArm3d& arm, const std::vector<double>& q) {
+    SE3 T;
+    for (size_t i = 0; i < arm.dof(); ++i) {
+        const DHParams& p = arm.links()[i];
+        SE3 rz(Matrix3::rotation_z(p.theta + q[i]), Vector3{0.0, 0.0, 0.0});
+        SE3 tz(Matrix3::identity(), Vector3{0.0, 0.0, p.d});
+        SE3 tx(Matrix3::identity(), Vector3{p.a, 0.0, 0.0});
+        SE3 rx(Matrix3::rotation_x(p.alpha), Vector3{0.0, 0.0, 0.0});
+        T = T * rz * tz * tx * rx;
+    }
+    return T;
+}
+
+void assert_se3_near(const SE3& A, const SE3& B) {
+    assert(std::abs(A.R.m00 - B.R.m00) < EPS);
+    assert(std::abs(A.R.m01 - B.R.m01) < EPS);
+    assert(std::abs(A.R.m02 - B.R.m02) < EPS);
+    assert(std::abs(A.R.m10 - B.R.m10) < EPS);
+    assert(std::abs(A.R.m11 - B.R.m11) < EPS);
+    assert(std::abs(A.R.m12 - B.R.m12) < EPS);
+    assert(std::abs(A.R.m20 - B.R.m20) < EPS);
+    assert(std::abs(A.R.m21 - B.R.m21) < EPS);
+    assert(std::abs(A.R.m22 - B.R.m22) < EPS);
+    assert(std::abs(A.t.x - B.t.x) < EPS);
+    assert(std::abs(A.t.y - B.t.y) < EPS);
+    assert(std::abs(A.t.z - B.t.z) < EPS);
+}
+
+// ----------------------------------------------
+// Test 1: Planar DH chain behaves like a planar arm
+// ----------------------------------------------
+void test_planar_chain() {
+    RobotArm3d arm{
+        {1.0, 0.0, 0.0, 0.0},
+        {1.0, 0.0, 0.0, 0.0}
+    };
+
+    SE3 T = arm.forward_kinematics({0.0, 0.0});
+    assert(std::abs(T.t.x - 2.0) < EPS);
+    assert(std::abs(T.t.y - 0.0) < EPS);
+
+    //standard joint angles: world link angle is q1 + q2
+    T = arm.forward_kinematics({M_PI/2, -M_PI/2});
+    assert(std::abs(T.t.x - 1.0) < EPS);
+    assert(std::abs(T.t.y - 1.0) < EPS);
+    assert(std::abs(T.t.z - 0.0) < EPS);
+}
+
+// ----------------------------------------------
+// Test 2: Matches composed DH transforms on a 6-DOF arm
+// ----------------------------------------------
+void test_matches_reference() {
+    RobotArm3d arm = make_ur5();
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    for (int k = 0; k < 100; ++k) {
+        std::vector<double> q(6);
+        for (auto& v : q) v = angle(rng);
+        assert_se3_near(arm.forward_kinematics(q), reference_fk(arm, q));
+    }
+}
+
+// ----------------------------------------------
+// Test 3: Joint offsets are applied
+// ----------------------------------------------
+void test_theta_offset() {
+    RobotArm3d arm{{1.0, 0.0, 0.5, M_PI/2}};
+
+    SE3 T = arm.forward_kinematics({0.0});
+    assert(std::abs(T.t.x - 0.0) < EPS);
+    assert(std::abs(T.t.y - 1.0) < EPS);
+    assert(std::abs(T.t.z - 0.5) < EPS);
+}
+
+// ----------------------------------------------
+// Test 4: Joint frames are the prefix transforms
+// ----------------------------------------------
+void test_joint_frames() {
+    RobotArm3d arm = make_ur5();
+    std::vector<double> q = {0.3, -1.1, 0.7, 0.2, 1.4, -0.5};
+
+    std::vector<SE3> frames;
+    SE3 T = arm.forward_kinematics(q, frames);
+
+    assert(frames.size() == 6);
+    assert_se3_near(T, arm.forward_kinematics(q));
+    assert_se3_near(frames[0], SE3());
+
+    for (size_t i = 1; i < 6; ++i) {
+        std::vector<double> prefix_q(q.begin(), q.begin() + i);
+        RobotArm3d prefix(std::vector<DHParams>(arm.links().begin(), arm.links().begin() + i));
+        assert_se3_near(frames[i], prefix.forward_kinematics(prefix_q));
+    }
+}
+
+// ----------------------------------------------
+// Test 5: Batched FK matches per-configuration FK
+// ----------------------------------------------
+void test_batch_matches_scalar() {
+    RobotArm3d arm = make_ur5();
+    std::mt19937 rng(12);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    //larger than one tile, not a multiple of it
+    const size_t B = 600;
+    std::vector<double> q(6 * B);
+    for (auto& v : q) v = angle(rng);
+
+    std::vector<SE3> poses(B);
+    arm.forward_kinematics_batch(q.data(), B, poses.data());
+
+    for (size_t b = 0; b < B; ++b) {
+        std::vector<double> qb(6);
+        for (size_t i = 0; i < 6; ++i) qb[i] = q[i * B + b];
+        assert_se3_near(poses[b], arm.forward_kinematics(qb));
+    }
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_planar_chain();
+    test_matches_reference();
+    test_theta_offset();
+    test_joint_frames();
+    test_batch_matches_scalar();
+
+    std::cout << "All RobotArm3d tests passed\n";
+    return 0;
+}
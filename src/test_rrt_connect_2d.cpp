@@ -0,0 +1,215 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "robot/rrt_connect_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+#include "math/se2.hpp"
+
+using robot::RobotArm2d;
+using robot::RRTConnect2d;
+using robot::RRTPath2d;
+using robot::RRTTree2d;
+using math::Vector2;
+
+// ----------------------------------------------
+// Helper: arm links against circular obstacles
+// ----------------------------------------------
+struct Circle {
+    Vector2 c;
+    double r;
+};
+
+struct CircleScene {
+    const RobotArm2d& arm;
+    std::vector<Circle> obstacles;
+
+    bool operator()(const double* q) const {
+        thread_local std::vector<double> qv;
+        thread_local std::vector<Vector2> joints;
+        qv.assign(q, q + arm.link_lengths.size());
+        arm.joint_positions(qv, joints);
+        Vector2 tip = arm.forward_kinematics(qv) * Vector2{0.0, 0.0};
+
+        for (size_t i = 0; i < joints.size(); ++i) {
+            Vector2 a = joints[i];
+            Vector2 b = (i + 1 < joints.size()) ? joints[i + 1] : tip;
+            for (const auto& o : obstacles) {
+                Vector2 ab = b - a;
+                double t = std::max(0.0, std::min(1.0, (o.c - a).dot(ab) / ab.dot(ab)));
+                if ((a + ab * t - o.c).norm() < o.r)
+                    return false;
+            }
+        }
+        return true;
+    }
+};
+
+//every edge of the path checked at a much finer resolution
+bool path_is_free(const RRTPath2d& path, const CircleScene& scene) {
+    std::vector<double> q(path.dof);
+    for (size_t k = 1; k < path.size(); ++k) {
+        for (int s = 0; s <= 100; ++s) {
+            double t = s / 100.0;
+            for (size_t i = 0; i < path.dof; ++i)
+                q[i] = path.config(k - 1)[i] + t * (path.config(k)[i] - path.config(k - 1)[i]);
+            if (!scene(q.data()))
+                return false;
+        }
+    }
+    return true;
+}
+
+bool same_angles(const double* a, const std::vector<double>& b) {
+    for (size_t i = 0; i < b.size(); ++i)
+        if (std::abs(RRTTree2d::wrap_diff(a[i], b[i])) > 1e-9)
+            return false;
+    return true;
+}
+
+CircleScene cluttered_scene(const RobotArm2d& arm) {
+    return CircleScene{arm, {
+        {{1.0, 0.9}, 0.3}, {{-0.4, 1.2}, 0.3}, {{-1.2, -0.3}, 0.3},
+        {{0.3, -1.2}, 0.3}, {{1.3, -0.6}, 0.2}
+    }};
+}
+
+// ----------------------------------------------
+// Test 1: Nearest neighbour respects wraparound
+// ----------------------------------------------
+void test_nearest_wraparound() {
+    const size_t N = 3;
+    RRTTree2d tree(N, 2000);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    std::vector<double> q(N);
+    for (int k = 0; k < 2000; ++k) {
+        for (auto& v : q) v = angle(rng);
+        tree.add(q.data(), -1);
+    }
+    assert(tree.full());
+    assert(tree.add(q.data(), -1) == -1);
+
+    for (int k = 0; k < 300; ++k) {
+        //queries near the +-pi seam as well as anywhere
+        for (auto& v : q) v = (k % 2) ? angle(rng) : RRTTree2d::wrap(M_PI - 0.01 * angle(rng));
+
+        int32_t brute = 0;
+        double best = 1e300;
+        for (int32_t i = 0; i < static_cast<int32_t>(tree.size()); ++i) {
+            double d2 = RRTTree2d::distance2(q.data(), tree.config(i), N);
+            if (d2 < best) { best = d2; brute = i; }
+        }
+        int32_t found = tree.nearest(q.data());
+        assert(RRTTree2d::distance2(q.data(), tree.config(found), N) == best);
+        (void)brute;
+    }
+
+    //points just either side of the seam are neighbours
+    RRTTree2d seam(1, 4);
+    double a = M_PI - 0.01, b = 0.5, c = -M_PI + 0.02;
+    seam.add(&b, -1);
+    seam.add(&a, -1);
+    assert(seam.nearest(&c) == 1);
+}
+
+// ----------------------------------------------
+// Test 2: Free space connects start and goal directly
+// ----------------------------------------------
+void test_free_space() {
+    RobotArm2d arm{1.0, 0.8, 0.5};
+    CircleScene scene{arm, {}};
+    RRTConnect2d planner;
+
+    std::vector<double> start = {0.0, 0.5, -0.5}, goal = {2.5, -1.0, 1.0};
+    RRTPath2d path = planner.solve(arm, start, goal, scene);
+
+    assert(path.found);
+    assert(path.size() == 2);
+    assert(same_angles(path.config(0), start));
+    assert(same_angles(path.config(1), goal));
+}
+
+// ----------------------------------------------
+// Test 3: Cluttered scene, every edge collision-free
+// ----------------------------------------------
+void test_cluttered() {
+    RobotArm2d arm{0.6, 0.5, 0.4, 0.3};
+    CircleScene scene = cluttered_scene(arm);
+
+    std::vector<double> start = {0.0, 0.0, 0.0, 0.0};
+    std::vector<double> goal = {2.0, 0.3, -0.3, 0.2};
+    assert(scene(start.data()) && scene(goal.data()));
+
+    RRTConnect2d planner;
+    planner.check_resolution = 0.02;
+    RRTPath2d path = planner.solve(arm, start, goal, scene);
+
+    assert(path.found);
+    assert(path.size() > 2);
+    assert(same_angles(path.config(0), start));
+    assert(same_angles(path.config(path.size() - 1), goal));
+    assert(path_is_free(path, scene));
+
+    //consecutive waypoints take the short way round every joint
+    for (size_t k = 1; k < path.size(); ++k)
+        for (size_t i = 0; i < path.dof; ++i)
+            assert(std::abs(path.config(k)[i] - path.config(k - 1)[i]) <= M_PI);
+}
+
+// ----------------------------------------------
+// Test 4: Goal in collision fails immediately
+// ----------------------------------------------
+void test_goal_in_collision() {
+    RobotArm2d arm{0.6, 0.5, 0.4, 0.3};
+    CircleScene scene = cluttered_scene(arm);
+
+    std::vector<double> start = {0.0, 0.0, 0.0, 0.0};
+    std::vector<double> goal = {M_PI / 2, 0.0, 0.0, 0.0}; //straight through (-0.4, 1.2)? folded onto it
+    if (scene(goal.data()))
+        scene.obstacles.push_back({arm.forward_kinematics(goal) * Vector2{0.0, 0.0}, 0.05});
+    assert(!scene(goal.data()));
+
+    RRTPath2d path = RRTConnect2d{}.solve(arm, start, goal, scene);
+    assert(!path.found);
+    assert(path.iterations == 0);
+}
+
+// ----------------------------------------------
+// Test 5: Parallel mode returns the first connection
+// ----------------------------------------------
+void test_parallel() {
+    RobotArm2d arm{0.6, 0.5, 0.4, 0.3};
+    CircleScene scene = cluttered_scene(arm);
+    util::ThreadPool pool(3);
+
+    std::vector<double> start = {0.0, 0.0, 0.0, 0.0};
+    std::vector<double> goal = {2.0, 0.3, -0.3, 0.2};
+
+    RRTConnect2d planner;
+    planner.check_resolution = 0.02;
+    RRTPath2d path = planner.solve_parallel(arm, start, goal, scene, pool);
+
+    assert(path.found);
+    assert(same_angles(path.config(0), start));
+    assert(same_angles(path.config(path.size() - 1), goal));
+    assert(path_is_free(path, scene));
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_nearest_wraparound();
+    test_free_space();
+    test_cluttered();
+    test_goal_in_collision();
+    test_parallel();
+
+    std::cout << "All RRTConnect2d tests passed\n";
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "geometry/collision_scene_2d.hpp"
+#include "geometry/sdf_2d.hpp"
+#include "robot/arm_clearance_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "util/thread_pool.hpp"
+
+using geometry::AABB2d;
+using geometry::Box2d;
+using geometry::Capsule2d;
+using geometry::Circle2d;
+using geometry::CollisionScene2d;
+using geometry::SignedDistanceField2d;
+using math::Vector2;
+using robot::ArmClearance2d;
+using robot::RobotArm2d;
+
+static const AABB2d kRegion{{-2.0, -2.0}, {2.0, 2.0}};
+
+// ----------------------------------------------
+// Test 1: distances to a single circle
+// ----------------------------------------------
+void test_circle_distance() {
+    CollisionScene2d scene;
+    scene.add(Circle2d{{0.3, -0.2}, 0.5});
+    scene.build();
+
+    const double res = 0.02;
+    SignedDistanceField2d sdf = SignedDistanceField2d::build(scene, kRegion, res);
+    assert(sdf.width() == 201 && sdf.height() == 201);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> pos(-1.9, 1.9);
+    for (int k = 0; k < 2000; ++k) {
+        Vector2 p{pos(rng), pos(rng)};
+        double exact = (p - Vector2{0.3, -0.2}).norm() - 0.5;
+        assert(std::abs(sdf.distance(p) - exact) < 1.5 * res);
+    }
+
+    //sign and gradient direction
+    assert(sdf.distance({0.3, -0.2}) < -0.45);
+    Vector2 g = sdf.gradient({1.3, -0.2});
+    assert(std::abs(g.x - 1.0) < 0.05 && std::abs(g.y) < 0.05);
+    g = sdf.gradient({0.3, 0.8});
+    assert(std::abs(g.x) < 0.05 && std::abs(g.y - 1.0) < 0.05);
+}
+
+// ----------------------------------------------
+// Test 2: threaded build matches the serial one exactly
+// ----------------------------------------------
+void test_threaded_build() {
+    CollisionScene2d scene;
+    scene.add(Circle2d{{-0.8, 0.9}, 0.3});
+    scene.add(Box2d{{0.7, 0.2}, {0.4, 0.2}, 0.5});
+    scene.add(Capsule2d{{-1.0, -1.0}, {0.0, -1.3}, 0.1});
+    scene.build();
+
+    SignedDistanceField2d serial = SignedDistanceField2d::build(scene, kRegion, 0.03);
+    util::ThreadPool pool(4);
+    SignedDistanceField2d threaded = SignedDistanceField2d::build(scene, kRegion, 0.03, pool);
+
+    assert(serial.width() == threaded.width() && serial.height() == threaded.height());
+    for (size_t y = 0; y < serial.height(); ++y)
+        for (size_t x = 0; x < serial.width(); ++x)
+            assert(serial.at(x, y) == threaded.at(x, y));
+
+    //inside the box and outside everything
+    assert(serial.distance({0.7, 0.2}) < 0.0);
+    assert(serial.distance({1.8, -1.8}) > 0.5);
+}
+
+// ----------------------------------------------
+// Test 3: save and load round trip
+// ----------------------------------------------
+void test_save_load() {
+    CollisionScene2d scene;
+    scene.add(Box2d{{0.0, 0.5}, {0.3, 0.3}});
+    scene.build();
+    SignedDistanceField2d sdf = SignedDistanceField2d::build(scene, kRegion, 0.05);
+
+    const std::string path = "test_sdf_2d.bin";
+    assert(sdf.save(path));
+
+    SignedDistanceField2d loaded;
+    assert(SignedDistanceField2d::load(path, loaded));
+    assert(loaded.width() == sdf.width() && loaded.height() == sdf.height());
+    assert(loaded.resolution() == sdf.resolution());
+    assert((loaded.origin() - sdf.origin()).norm() == 0.0);
+    for (size_t y = 0; y < sdf.height(); ++y)
+        for (size_t x = 0; x < sdf.width(); ++x)
+            assert(loaded.at(x, y) == sdf.at(x, y));
+
+    //a header promising more samples than the file holds is rejected before
+    //anything is allocated for them
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::vector<char> huge = bytes;
+        const uint64_t side = uint64_t{1} << 20;
+        std::memcpy(huge.data() + 8, &side, sizeof(side));
+        std::memcpy(huge.data() + 16, &side, sizeof(side));
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(huge.data(), static_cast<std::streamsize>(huge.size()));
+    }
+    SignedDistanceField2d bad;
+    assert(!SignedDistanceField2d::load(path, bad));
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+    assert(!SignedDistanceField2d::load(path, bad));
+
+    //truncated file and wrong format are rejected
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write("SDF2", 4);
+    }
+    assert(!SignedDistanceField2d::load(path, bad));
+    assert(bad.empty());
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "not a distance field at all";
+    }
+    assert(!SignedDistanceField2d::load(path, bad));
+    std::remove(path.c_str());
+
+    assert(!SignedDistanceField2d::load("does_not_exist.bin", bad));
+}
+
+// ----------------------------------------------
+// Test 4: link clearance against exact narrowphase distances
+// ----------------------------------------------
+void test_link_clearance() {
+    RobotArm2d arm{0.6, 0.5, 0.4};
+
+    CollisionScene2d scene;
+    scene.add(Circle2d{{1.0, 0.8}, 0.2});
+    scene.add(Box2d{{-0.7, 0.6}, {0.15, 0.25}, 0.3});
+    scene.add(Circle2d{{0.2, -1.1}, 0.25});
+    scene.build();
+
+    const double res = 0.01;
+    const double radius = 0.03;
+    util::ThreadPool pool(2);
+    SignedDistanceField2d sdf = SignedDistanceField2d::build(scene, kRegion, res, pool);
+    ArmClearance2d clearance(arm, sdf, radius);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::vector<double> q(3), per_link;
+    std::vector<Vector2> points;
+
+    for (int k = 0; k < 300; ++k) {
+        for (auto& v : q) v = angle(rng);
+        double best = clearance.link_clearance(q, per_link, points);
+        assert(per_link.size() == 3);
+        assert(std::abs(best - clearance.min_clearance(q, points)) < 1e-12);
+
+        arm.link_points(q, points);
+        for (size_t i = 0; i < 3; ++i) {
+            Capsule2d link{points[i], points[i + 1], radius};
+            double exact = INFINITY;
+            for (size_t o = 0; o < scene.size(); ++o)
+                exact = std::min(exact, scene.distance(link, o));
+            //never more than the field's own error above the exact distance,
+            //whatever the sampling along the link
+            assert(per_link[i] <= exact + res);
+            //only comparable from below while the link is clear; inside, the
+            //exact distance saturates at 0
+            if (exact > 0.0)
+                assert(per_link[i] > exact - 2.0 * res);
+        }
+    }
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_circle_distance();
+    test_threaded_build();
+    test_save_load();
+    test_link_clearance();
+
+    std::cout << "All SDF tests passed\n";
+    return 0;
+}
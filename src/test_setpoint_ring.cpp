@@ -0,0 +1,215 @@
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "robot/cartesian_path_2d.hpp"
+#include "robot/ik_2d.hpp"
+#include "robot/robot_arm_2d.hpp"
+#include "robot/setpoint_ring.hpp"
+
+using robot::CartesianPlanner2d;
+using robot::CartesianPlannerWorkspace2d;
+using robot::CartesianSegment2d;
+using robot::IK2dPathResult;
+using robot::RobotArm2d;
+using robot::SetpointRing;
+using robot::SetpointStream;
+using math::Vector2;
+
+// ----------------------------------------------
+// Test 1: FIFO order, full and empty, wrap-around
+// ----------------------------------------------
+void test_single_thread() {
+    SetpointRing ring(3, 5);
+    assert(ring.dof() == 3);
+    assert(ring.capacity() == 8);
+    assert(ring.size() == 0);
+
+    double q[3];
+    assert(!ring.try_pop(q));
+    assert(ring.try_front() == nullptr);
+
+    //several laps so indices wrap
+    double next_in = 0.0, next_out = 0.0;
+    for (int lap = 0; lap < 5; ++lap) {
+        while (true) {
+            double in[3] = {next_in, next_in + 0.5, -next_in};
+            if (!ring.try_push(in))
+                break;
+            next_in += 1.0;
+        }
+        assert(ring.size() == ring.capacity());
+        assert(ring.try_claim() == nullptr);
+
+        //drain half
+        for (int i = 0; i < 4; ++i) {
+            bool popped = ring.try_pop(q);
+            assert(popped);
+            (void)popped;
+            assert(q[0] == next_out && q[1] == next_out + 0.5 && q[2] == -next_out);
+            next_out += 1.0;
+        }
+        assert(ring.size() == 4);
+    }
+    while (ring.try_pop(q)) {
+        assert(q[0] == next_out);
+        next_out += 1.0;
+    }
+    assert(next_out == next_in);
+    assert(ring.size() == 0);
+    assert(!ring.finished());
+    ring.close();
+    assert(ring.finished());
+}
+
+// ----------------------------------------------
+// Test 2: In-place claim/commit and front/release
+// ----------------------------------------------
+void test_in_place() {
+    SetpointRing ring(9, 4); //more than one cache line per slot
+
+    double* slot = ring.try_claim();
+    assert(slot != nullptr);
+    assert(reinterpret_cast<uintptr_t>(slot) % 64 == 0);
+    for (int i = 0; i < 9; ++i) slot[i] = i;
+    //not visible before commit
+    assert(ring.try_front() == nullptr);
+    ring.commit();
+
+    const double* front = ring.try_front();
+    assert(front != nullptr);
+    for (int i = 0; i < 9; ++i) assert(front[i] == i);
+    //front stays put until released
+    assert(ring.try_front() == front);
+    ring.release();
+    assert(ring.try_front() == nullptr);
+
+    //consecutive slots start on separate cache lines
+    double* a = ring.try_claim();
+    ring.commit();
+    double* b = ring.try_claim();
+    ring.commit();
+    assert(reinterpret_cast<uintptr_t>(b) - reinterpret_cast<uintptr_t>(a) >= 128);
+}
+
+// ----------------------------------------------
+// Test 3: Producer and consumer threads, every setpoint arrives in order
+// ----------------------------------------------
+void test_threads() {
+    const size_t dof = 6;
+    const uint64_t count = 200000;
+    SetpointRing ring(dof, 16);
+
+    std::thread producer([&] {
+        SetpointStream stream(ring);
+        double q[dof];
+        for (uint64_t i = 0; i < count; ++i) {
+            for (size_t j = 0; j < dof; ++j)
+                q[j] = static_cast<double>(i * dof + j);
+            bool pushed = stream.push(q);
+            assert(pushed);
+            (void)pushed;
+        }
+        ring.close();
+    });
+
+    uint64_t received = 0;
+    bool ordered = true;
+    double q[dof];
+    while (!ring.finished()) {
+        if (!ring.try_pop(q)) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t j = 0; j < dof; ++j)
+            ordered = ordered && q[j] == static_cast<double>(received * dof + j);
+        ++received;
+    }
+    producer.join();
+
+    assert(ordered);
+    assert(received == count);
+}
+
+// ----------------------------------------------
+// Test 4: A Cartesian planner streams straight into the ring
+// ----------------------------------------------
+void test_planner_stream() {
+    RobotArm2d arm{1.0, 0.8, 0.5};
+    std::vector<CartesianSegment2d> path = {
+        CartesianSegment2d::line(Vector2{1.5, 0.0}, Vector2{1.5, 0.6}),
+        CartesianSegment2d::line(Vector2{1.5, 0.6}, Vector2{0.9, 0.9})};
+    std::vector<double> q0 = {0.1, 0.1, 0.1};
+
+    CartesianPlanner2d planner;
+    planner.resolution = 0.01;
+    IK2dPathResult expected = planner.plan(arm, path, q0);
+
+    //far smaller than the path, so the planner has to wait for the controller
+    SetpointRing ring(arm.link_lengths.size(), 8);
+    std::thread planning([&] {
+        CartesianPlannerWorkspace2d ws(arm);
+        SetpointStream stream(ring);
+        auto summary = planner.stream(arm, path, q0, ws, stream);
+        assert(!summary.stopped);
+        ring.close();
+    });
+
+    std::vector<double> received;
+    double q[3];
+    while (!ring.finished()) {
+        if (ring.try_pop(q))
+            received.insert(received.end(), q, q + 3);
+        else
+            std::this_thread::yield();
+    }
+    planning.join();
+
+    assert(received == expected.q);
+}
+
+// ----------------------------------------------
+// Test 5: Cancelling a stream stops the planner while the ring is full
+// ----------------------------------------------
+void test_cancel() {
+    RobotArm2d arm{1.0, 0.8, 0.5};
+    std::vector<CartesianSegment2d> path = {
+        CartesianSegment2d::line(Vector2{1.5, 0.0}, Vector2{1.5, 0.6})};
+
+    CartesianPlanner2d planner;
+    planner.resolution = 0.01;
+
+    SetpointRing ring(arm.link_lengths.size(), 4);
+    std::atomic<bool> cancel{false};
+    std::thread planning([&] {
+        CartesianPlannerWorkspace2d ws(arm);
+        auto summary = planner.stream(arm, path, {0.1, 0.1, 0.1}, ws, SetpointStream(ring, &cancel));
+        assert(summary.stopped);
+        assert(summary.waypoints == ring.capacity() + 1);
+    });
+
+    //nobody consumes; wait for the ring to fill, then cancel
+    while (ring.size() < ring.capacity())
+        std::this_thread::yield();
+    cancel.store(true);
+    planning.join();
+    assert(ring.size() == ring.capacity());
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_single_thread();
+    test_in_place();
+    test_threads();
+    test_planner_stream();
+    test_cancel();
+
+    std::cout << "All SetpointRing tests passed\n";
+    return 0;
+}
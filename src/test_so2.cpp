@@ -0,0 +1,112 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+#include "math/vector2.hpp"
+#include "math/matrix2.hpp"
+#include "math/se2.hpp"
+#include "math/so2.hpp"
+#include "math/se2_compact.hpp"
+
+using math::Vector2;
+using math::Matrix2;
+using math::SE2;
+using math::SE2Compact;
+using math::SO2;
+
+// --------------------------
+// SO2 Tests
+// --------------------------
+
+void test_so2_compose_adds_angles() {
+    SO2 a = SO2::from_angle(0.4);
+    SO2 b = SO2::from_angle(-1.1);
+    SO2 r = a * b;
+
+    assert(std::abs(r.angle() - (0.4 - 1.1)) < 1e-12);
+    assert(std::abs((a * a.inverse()).angle()) < 1e-12);
+}
+
+void test_so2_rotate_vector() {
+    SO2 R = SO2::from_angle(M_PI / 2.0);
+    Vector2 r = R * Vector2{1.0, 0.0};
+
+    assert(std::abs(r.x - 0.0) < 1e-9);
+    assert(std::abs(r.y - 1.0) < 1e-9);
+}
+
+void test_so2_matrix_round_trip() {
+    SO2 R = SO2::from_angle(2.3);
+    Matrix2 M = R.to_matrix();
+    Matrix2 expected = Matrix2::rotation(2.3);
+
+    assert(std::abs(M.m00 - expected.m00) < 1e-12);
+    assert(std::abs(M.m01 - expected.m01) < 1e-12);
+    assert(std::abs(M.m10 - expected.m10) < 1e-12);
+    assert(std::abs(M.m11 - expected.m11) < 1e-12);
+
+    SO2 back = SO2::from_matrix(M);
+    assert(std::abs(back.c - R.c) < 1e-15 && std::abs(back.s - R.s) < 1e-15);
+}
+
+void test_so2_renormalize() {
+    //a rotation scaled off the unit circle is pulled back
+    SO2 R(1.0001 * std::cos(0.7), 1.0001 * std::sin(0.7));
+    R.renormalize();
+    R.renormalize();
+    assert(std::abs(R.c * R.c + R.s * R.s - 1.0) < 1e-12);
+    assert(std::abs(R.angle() - 0.7) < 1e-12);
+
+    //long composition chains stay on the circle with periodic renormalization
+    SO2 step = SO2::from_angle(0.001);
+    SO2 acc;
+    for (int i = 1; i <= 100000; ++i) {
+        acc = acc * step;
+        if (i % 16 == 0) acc.renormalize();
+    }
+    assert(std::abs(acc.c * acc.c + acc.s * acc.s - 1.0) < 1e-12);
+    assert(std::abs(acc.angle() - std::remainder(100.0, 2.0 * M_PI)) < 1e-9);
+}
+
+// --------------------------
+// SE2Compact Tests
+// --------------------------
+
+void test_se2_compact_matches_se2() {
+    SE2 A = SE2::from_angle_translation(0.3, Vector2{1.0, -2.0});
+    SE2 B = SE2::from_angle_translation(-1.2, Vector2{0.5, 0.7});
+    SE2Compact a(A), b(B);
+
+    SE2 AB = A * B;
+    SE2 ab = (a * b).to_se2();
+    assert(std::abs(AB.R.m00 - ab.R.m00) < 1e-12);
+    assert(std::abs(AB.R.m10 - ab.R.m10) < 1e-12);
+    assert(std::abs(AB.t.x - ab.t.x) < 1e-12);
+    assert(std::abs(AB.t.y - ab.t.y) < 1e-12);
+
+    Vector2 p{0.3, 4.0};
+    Vector2 r1 = A * p;
+    Vector2 r2 = a * p;
+    assert(std::abs(r1.x - r2.x) < 1e-12 && std::abs(r1.y - r2.y) < 1e-12);
+}
+
+void test_se2_compact_inverse() {
+    SE2Compact T = SE2Compact::from_angle_translation(0.9, Vector2{2.0, 1.0});
+    SE2Compact I = T * T.inverse();
+
+    assert(std::abs(I.R.c - 1.0) < 1e-12);
+    assert(std::abs(I.R.s - 0.0) < 1e-12);
+    assert(std::abs(I.t.x) < 1e-12 && std::abs(I.t.y) < 1e-12);
+}
+
+int main() {
+    test_so2_compose_adds_angles();
+    test_so2_rotate_vector();
+    test_so2_matrix_round_trip();
+    test_so2_renormalize();
+    test_se2_compact_matches_se2();
+    test_se2_compact_inverse();
+
+    std::cout << "All SO2 tests passed\n";
+    return 0;
+}
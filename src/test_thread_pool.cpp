@@ -0,0 +1,129 @@
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "util/thread_pool.hpp"
+
+using util::ThreadPool;
+
+// ----------------------------------------------
+// Test 1: Every index runs exactly once
+// ----------------------------------------------
+void test_each_index_once() {
+    ThreadPool pool(4);
+    assert(pool.size() == 4);
+
+    std::vector<std::atomic<int>> hits(1000);
+    for (auto& h : hits) h = 0;
+
+    pool.run(hits.size(), [&](size_t i, size_t slot) {
+        assert(slot < pool.size());
+        hits[i].fetch_add(1);
+    });
+
+    for (auto& h : hits)
+        assert(h.load() == 1);
+}
+
+// ----------------------------------------------
+// Test 2: Pool is reusable across many jobs
+// ----------------------------------------------
+void test_repeated_runs() {
+    ThreadPool pool(3);
+    std::atomic<long> sum{0};
+
+    for (int rep = 0; rep < 200; ++rep) {
+        pool.run(17, [&](size_t i, size_t) {
+            sum.fetch_add(static_cast<long>(i));
+        });
+    }
+
+    //0 + 1 + ... + 16 = 136 per job
+    assert(sum.load() == 200 * 136);
+}
+
+// ----------------------------------------------
+// Test 3: Single-slot pool runs inline, in order
+// ----------------------------------------------
+void test_single_slot_inline() {
+    ThreadPool pool(1);
+    assert(pool.size() == 1);
+
+    std::vector<size_t> order;
+    pool.run(5, [&](size_t i, size_t slot) {
+        assert(slot == 0);
+        order.push_back(i);
+    });
+
+    assert((order == std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+// ----------------------------------------------
+// Test 4: Empty job returns immediately
+// ----------------------------------------------
+void test_empty_job() {
+    ThreadPool pool(2);
+    bool called = false;
+    pool.run(0, [&](size_t, size_t) { called = true; });
+    assert(!called);
+}
+
+// ----------------------------------------------
+// Test 5: An exception on any slot reaches the caller, the pool stays usable
+// ----------------------------------------------
+void test_exception() {
+    ThreadPool pool(3);
+    for (size_t thrower : {size_t{0}, size_t{7}, size_t{999}}) {
+        std::atomic<size_t> ran{0};
+        bool caught = false;
+        try {
+            pool.run(1000, [&](size_t index, size_t) {
+                if (index == thrower)
+                    throw std::runtime_error("index failed");
+                ran.fetch_add(1, std::memory_order_relaxed);
+            });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        assert(caught);
+        assert(ran.load() < 1000);
+    }
+
+    std::atomic<size_t> ran{0};
+    pool.run(100, [&](size_t, size_t) { ran.fetch_add(1, std::memory_order_relaxed); });
+    assert(ran.load() == 100);
+}
+
+// ----------------------------------------------
+// Test 6: Jobs may run jobs on another pool
+// ----------------------------------------------
+void test_nested_other_pool() {
+    ThreadPool outer(3), inner(2);
+    std::atomic<size_t> ran{0};
+    outer.run(8, [&](size_t, size_t) {
+        inner.run(10, [&](size_t, size_t) { ran.fetch_add(1, std::memory_order_relaxed); });
+    });
+    assert(ran.load() == 80);
+
+    //both pools are usable from the caller afterwards
+    outer.run(5, [&](size_t, size_t) { ran.fetch_add(1, std::memory_order_relaxed); });
+    inner.run(5, [&](size_t, size_t) { ran.fetch_add(1, std::memory_order_relaxed); });
+    assert(ran.load() == 90);
+}
+
+// --------------------------------
+// Main
+// --------------------------------
+int main() {
+    test_each_index_once();
+    test_repeated_runs();
+    test_single_slot_inline();
+    test_empty_job();
+    test_exception();
+    test_nested_other_pool();
+
+    std::cout << "All ThreadPool tests passed\n";
+    return 0;
+}
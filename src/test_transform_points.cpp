@@ -0,0 +1,140 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "math/transform_points.hpp"
+#include "math/se2.hpp"
+#include "math/se3.hpp"
+
+using math::Matrix3;
+using math::SE2;
+using math::SE3;
+using math::Vector2;
+using math::Vector3;
+
+static constexpr double EPS = 1e-12;
+
+//sizes around the SIMD widths plus a large one
+static const size_t kSizes[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 1001};
+
+SE2 random_se2(std::mt19937& rng) {
+    std::uniform_real_distribution<double> u(-3.0, 3.0);
+    return SE2::from_angle_translation(u(rng), Vector2{u(rng), u(rng)});
+}
+
+SE3 random_se3(std::mt19937& rng) {
+    std::uniform_real_distribution<double> u(-3.0, 3.0);
+    Matrix3 R = Matrix3::rotation_z(u(rng)) * Matrix3::rotation_y(u(rng)) * Matrix3::rotation_x(u(rng));
+    return SE3::from_rotation_translation(R, Vector3{u(rng), u(rng), u(rng)});
+}
+
+// ------------------------
+// Test 1: SE2 AoS matches per-point transform
+// ------------------------
+void test_se2_aos() {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> u(-10.0, 10.0);
+
+    for (size_t n : kSizes) {
+        SE2 T = random_se2(rng);
+        std::vector<Vector2> in(n), out(n);
+        for (auto& p : in) p = Vector2{u(rng), u(rng)};
+
+        math::transform_points(T, in.data(), out.data(), n);
+        std::vector<Vector2> inplace = in;
+        math::transform_points(T, inplace.data(), n);
+
+        for (size_t i = 0; i < n; ++i) {
+            Vector2 r = T * in[i];
+            assert(std::abs(out[i].x - r.x) < EPS && std::abs(out[i].y - r.y) < EPS);
+            assert(std::abs(inplace[i].x - r.x) < EPS && std::abs(inplace[i].y - r.y) < EPS);
+        }
+    }
+}
+
+// ------------------------
+// Test 2: SE2 SoA matches per-point transform
+// ------------------------
+void test_se2_soa() {
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> u(-10.0, 10.0);
+
+    for (size_t n : kSizes) {
+        SE2 T = random_se2(rng);
+        std::vector<double> x(n), y(n), ox(n), oy(n);
+        for (size_t i = 0; i < n; ++i) { x[i] = u(rng); y[i] = u(rng); }
+
+        math::transform_points(T, x.data(), y.data(), ox.data(), oy.data(), n);
+        std::vector<double> ix = x, iy = y;
+        math::transform_points(T, ix.data(), iy.data(), n);
+
+        for (size_t i = 0; i < n; ++i) {
+            Vector2 r = T * Vector2{x[i], y[i]};
+            assert(std::abs(ox[i] - r.x) < EPS && std::abs(oy[i] - r.y) < EPS);
+            assert(std::abs(ix[i] - r.x) < EPS && std::abs(iy[i] - r.y) < EPS);
+        }
+    }
+}
+
+// ------------------------
+// Test 3: SE3 AoS matches per-point transform
+// ------------------------
+void test_se3_aos() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> u(-10.0, 10.0);
+
+    for (size_t n : kSizes) {
+        SE3 T = random_se3(rng);
+        std::vector<Vector3> in(n), out(n);
+        for (auto& p : in) p = Vector3{u(rng), u(rng), u(rng)};
+
+        math::transform_points(T, in.data(), out.data(), n);
+        std::vector<Vector3> inplace = in;
+        math::transform_points(T, inplace.data(), n);
+
+        for (size_t i = 0; i < n; ++i) {
+            Vector3 r = T * in[i];
+            assert((out[i] - r).norm() < EPS);
+            assert((inplace[i] - r).norm() < EPS);
+        }
+    }
+}
+
+// ------------------------
+// Test 4: SE3 SoA matches per-point transform
+// ------------------------
+void test_se3_soa() {
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<double> u(-10.0, 10.0);
+
+    for (size_t n : kSizes) {
+        SE3 T = random_se3(rng);
+        std::vector<double> x(n), y(n), z(n), ox(n), oy(n), oz(n);
+        for (size_t i = 0; i < n; ++i) { x[i] = u(rng); y[i] = u(rng); z[i] = u(rng); }
+
+        math::transform_points(T, x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), n);
+        std::vector<double> ix = x, iy = y, iz = z;
+        math::transform_points(T, ix.data(), iy.data(), iz.data(), n);
+
+        for (size_t i = 0; i < n; ++i) {
+            Vector3 r = T * Vector3{x[i], y[i], z[i]};
+            assert((Vector3{ox[i], oy[i], oz[i]} - r).norm() < EPS);
+            assert((Vector3{ix[i], iy[i], iz[i]} - r).norm() < EPS);
+        }
+    }
+}
+
+// ------------------------
+// Main
+// ------------------------
+int main() {
+    test_se2_aos();
+    test_se2_soa();
+    test_se3_aos();
+    test_se3_soa();
+
+    std::cout << "All transform_points tests passed\n";
+    return 0;
+}